@@ -19,6 +19,7 @@
 #include <atomic>
 #include <chrono> // `std::chrono::` functions and classes, e.g. std::chrono::milliseconds
 #include <cstdio> // sscanf
+#include <sstream> // std::stringstream
 #include <string>
 #include <thread> // std::this_thread
 #include <vector>
@@ -55,14 +56,22 @@ DEFINE_double(camera_fps,               30.0,           "Frame rate for the webc
                                                         " minimum value between the OpenPose displayed speed and the webcam real frame rate.");
 DEFINE_string(video,                    "",             "Use a video file instead of the camera. Use `examples/media/video.avi` for our default"
                                                         " example video.");
+DEFINE_int32(video_prefetch,            0,              "Number of video frames decoded ahead on a background thread (only with `video`). Select 0 to"
+                                                        " decode them synchronously.");
 DEFINE_string(image_dir,                "",             "Process a directory of images. Use `examples/media/` for our default example folder with 20"
                                                         " images.");
+DEFINE_int32(image_read_ahead,          0,              "Number of following images read and decoded in background while processing the current one"
+                                                        " (only with `image_dir`). Select 0 to read them synchronously.");
+DEFINE_int32(image_decoding_threads,    2,              "Number of threads decoding the `image_read_ahead` images in parallel.");
 DEFINE_uint64(frame_first,              0,              "Start on desired frame number. Indexes are 0-based, i.e. the first frame has index 0.");
 DEFINE_uint64(frame_last,               -1,             "Finish on desired frame number. Select -1 to disable. Indexes are 0-based, e.g. if set to"
                                                         " 10, it will process 11 frames (0-10).");
 DEFINE_bool(frame_flip,                 false,          "Flip/mirror each frame (e.g. for real time webcam demonstrations).");
 DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 possible values: 0, 90, 180, 270.");
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
+DEFINE_string(roi_mask,                 "",             "Static region of interest: path to a grayscale image with the input resolution, where non-zero"
+                                                        " pixels are the area where people can appear. Only its bounding box is processed by the body"
+                                                        " network and body parts outside it are ignored. Empty to process the whole frame.");
 // OpenPose
 DEFINE_string(model_folder,             "models/",      "Folder path (absolute or relative) where the models (pose, face, ...) are located.");
 DEFINE_string(resolution,               "1280x720",     "The image resolution (display and output). Use \"-1x-1\" to force the program to use the"
@@ -92,12 +101,59 @@ DEFINE_bool(heatmaps_add_parts,         false,          "If true, it will add th
 DEFINE_bool(heatmaps_add_bkg,           false,          "Same functionality as `add_heatmaps_parts`, but adding the heatmap corresponding to"
                                                         " background.");
 DEFINE_bool(heatmaps_add_PAFs,          false,          "Same functionality as `add_heatmaps_parts`, but adding the PAFs.");
+DEFINE_int32(keyframe_interval,         1,              "Video/webcam tracking mode: the body network only runs every `keyframe_interval` frames"
+                                                        " (or when the tracking is lost) and the keypoints are propagated with optical flow on the"
+                                                        " frames in between. 1 runs the network on every frame. Recommended with `num_gpu 1`.");
+DEFINE_double(tracking_min_ratio,       0.5,            "Minimum ratio of tracked keypoints. Below it, the body network is run on that frame. No"
+                                                        " effect if `keyframe_interval` is 1.");
+DEFINE_double(tracking_max_error,       30.,            "Maximum optical flow error of a keypoint to consider it tracked. No effect if"
+                                                        " `keyframe_interval` is 1.");
+DEFINE_int32(roi_full_frame_interval,   0,              "Person ROI mode: the body network only processes the padded region around the people of"
+                                                        " the previous frame, and the full frame every `roi_full_frame_interval` frames (to detect"
+                                                        " new people). 0 to disable it. Not compatible with `keyframe_interval` > 1.");
+DEFINE_double(roi_padding,              0.2,            "Padding of the person ROI on each side, relative to its biggest side.");
+DEFINE_double(motion_gate_threshold,    0.,             "Static cameras: if the mean absolute difference (range [0, 255]) between a downscaled"
+                                                        " version of the frame and the last processed one is below this value, the networks are"
+                                                        " skipped and the last keypoints are reused. 0 to disable it (e.g. 2 for fixed cameras)."
+                                                        " Not compatible with several GPUs (`num_gpu` must be 1).");
+DEFINE_int32(motion_gate_max_skips,     30,             "Maximum number of consecutive frames skipped by `motion_gate_threshold`.");
+DEFINE_double(tile_scale,               0.,             "Tiled mode for 4K/8K inputs: the frame is split into overlapping tiles of `net_resolution` at"
+                                                        " `tile_scale` times the input resolution (1 = original resolution), processed as a single"
+                                                        " network batch (the GPU memory grows with the number of tiles). Their heat maps and PAFs"
+                                                        " are merged before connecting the body parts, so the people on the seams are found once."
+                                                        " 0 to disable it. Not compatible with `keyframe_interval` > 1, the person ROI mode nor"
+                                                        " `parallel_scales`.");
+DEFINE_double(tile_overlap,             0.25,           "Overlap between consecutive tiles, relative to the tile size. The tiles fade towards their"
+                                                        " borders in the merged heat maps, so the overlap gives the network context around the"
+                                                        " seams.");
+DEFINE_double(cascade_max_height,       0.,             "Two-stage cascade: people whose height is below `cascade_max_height` times the frame height"
+                                                        " are processed again on an upscaled crop around them. Use it with a low `net_resolution`"
+                                                        " to keep the accuracy on distant people. 0 to disable it (e.g. 0.3).");
+DEFINE_int32(cascade_max_crops,         4,              "Maximum number of extra crops per frame of `cascade_max_height`.");
+DEFINE_double(latency_budget,           0.,             "Latency budget (in milliseconds) per frame, from the producer to the pose output. The net"
+                                                        " resolution steps among `latency_net_resolutions` in order to stay within it. 0 to"
+                                                        " disable it.");
+DEFINE_string(latency_net_resolutions,  "656x368,496x272,320x176", "Comma-separated net resolutions for `latency_budget`, from the highest"
+                                                        " to the lowest one. It must contain `net_resolution`.");
+DEFINE_bool(sparse_heatmaps,            false,          "Only resize the body part heat maps around the areas that can contain keypoints (same"
+                                                        " keypoints, faster post-processing). Only applied with `num_scales` 1 and without"
+                                                        " `heatmaps_add_parts`.");
+DEFINE_bool(parallel_scales,            false,          "Many-core CPU hosts: if `num_scales` > 1, each scale runs concurrently on the CPU with its"
+                                                        " own network instance (sharing the weights) instead of as a single GPU batch.");
+DEFINE_bool(dynamic_net_width,          false,          "Adapt the width of `net_resolution` to the aspect ratio of each frame (rounded up to a"
+                                                        " multiple of 16), keeping its height. E.g. portrait or 4:3 videos do not waste network"
+                                                        " computation on padding.");
 // OpenPose Face
 DEFINE_bool(face,                       false,          "Enables face keypoint detection. It will share some parameters from the body pose, e.g."
                                                         " `model_folder`.");
 DEFINE_string(face_net_resolution,      "368x368",      "Multiples of 16. Analogous to `net_resolution` but applied to the face keypoint detector."
                                                         " 320x320 usually works fine while giving a substantial speed up when multiple faces on the"
                                                         " image.");
+DEFINE_double(face_cache_min_iou,       0.,             "Static faces: if the face rectangle overlaps the one of the previous frame with at least"
+                                                        " this IoU, its previous keypoints are reused instead of running the face network. 0 to"
+                                                        " disable it (e.g. 0.9).");
+DEFINE_int32(face_cache_refresh_interval, 10,           "Maximum number of consecutive frames a face can reuse its keypoints with"
+                                                        " `face_cache_min_iou`.");
 // OpenPose Hand
 DEFINE_bool(hand,                       false,          "Enables hand keypoint detection. It will share some parameters from the body pose, e.g."
                                                         " `model_folder`.");
@@ -109,6 +165,13 @@ DEFINE_int32(hand_detection_mode,       -1,             "Set to 0 to perform 1-t
                                                         " resulting frame rate is still >10 FPS and for video, ideally best result but slower), or"
                                                         " -1 (default) for automatic selection (fast method for webcam, tracking for video and"
                                                         " iterative for images).");
+// OpenPose Face and Hand
+DEFINE_int32(face_hand_max_people,      0,              "Maximum number of people per frame processed by the face and hand detectors, the"
+                                                        " remaining ones get their keypoint scores set to -1 (not evaluated). 0 to process"
+                                                        " everybody.");
+DEFINE_int32(face_hand_priority,        0,              "Criterion to select the `face_hand_max_people` people: 0 for the biggest ones, 1 for the"
+                                                        " closest ones to `face_hand_point`.");
+DEFINE_string(face_hand_point,          "640x360",      "Point of interest (in `resolution` coordinates) of `face_hand_priority` 1.");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Part to show from the start.");
 DEFINE_bool(disable_blending,           false,          "If blending is enabled, it will merge the results with the original frame. If disabled, it"
@@ -217,15 +280,16 @@ op::ProducerType gflagsToProducerType(const std::string& imageDirectory, const s
 }
 
 std::shared_ptr<op::Producer> gflagsToProducer(const std::string& imageDirectory, const std::string& videoPath, const int webcamIndex,
-                                               const op::Point<int> webcamResolution, const double webcamFps)
+                                               const op::Point<int> webcamResolution, const double webcamFps,
+                                               const int imageReadAhead, const int imageDecodingThreads, const int videoPrefetch)
 {
     op::log("", op::Priority::Low, __LINE__, __FUNCTION__, __FILE__);
     const auto type = gflagsToProducerType(imageDirectory, videoPath, webcamIndex);
 
     if (type == op::ProducerType::ImageDirectory)
-        return std::make_shared<op::ImageDirectoryReader>(imageDirectory);
+        return std::make_shared<op::ImageDirectoryReader>(imageDirectory, imageReadAhead, imageDecodingThreads);
     else if (type == op::ProducerType::Video)
-        return std::make_shared<op::VideoReader>(videoPath);
+        return std::make_shared<op::VideoReader>(videoPath, videoPrefetch);
     else if (type == op::ProducerType::Webcam)
         return std::make_shared<op::WebcamReader>(webcamIndex, webcamResolution, webcamFps);
     else
@@ -291,6 +355,41 @@ op::RenderMode gflagToRenderMode(const int renderFlag, const int renderPoseFlag
     }
 }
 
+std::vector<op::Point<int>> gflagToNetResolutions(const std::string& netResolutionsString)
+{
+    std::vector<op::Point<int>> netResolutions;
+    std::stringstream netResolutionsStream{netResolutionsString};
+    std::string netResolutionString;
+    while (std::getline(netResolutionsStream, netResolutionString, ','))
+    {
+        op::Point<int> netResolution;
+        const auto nRead = sscanf(netResolutionString.c_str(), "%dx%d", &netResolution.x, &netResolution.y);
+        op::checkE(nRead, 2, "Error, net resolution format (" +  netResolutionString + ") invalid, should be e.g., 656x368 (multiples"
+                   " of 16)", __LINE__, __FUNCTION__, __FILE__);
+        netResolutions.emplace_back(netResolution);
+    }
+    return netResolutions;
+}
+
+op::PersonPriority gflagToPersonPriority(const int personPriorityFlag)
+{
+    if (personPriorityFlag == 0)
+        return op::PersonPriority::Area;
+    else if (personPriorityFlag == 1)
+        return op::PersonPriority::Distance;
+    // else
+    op::error("Undefined PersonPriority selected.", __LINE__, __FUNCTION__, __FILE__);
+    return op::PersonPriority::Area;
+}
+
+op::Point<float> gflagToPointOfInterest(const std::string& pointString)
+{
+    op::Point<float> point;
+    const auto nRead = sscanf(pointString.c_str(), "%fx%f", &point.x, &point.y);
+    op::checkE(nRead, 2, "Error, point format (" +  pointString + ") invalid, should be e.g., 640x360", __LINE__, __FUNCTION__, __FILE__);
+    return point;
+}
+
 // Google flags into program variables
 std::tuple<op::Point<int>, op::Point<int>, op::Point<int>, op::Point<int>, std::shared_ptr<op::Producer>, op::PoseModel, op::ScaleMode,
            std::vector<op::HeatMapType>> gflagsToOpParameters()
@@ -322,7 +421,8 @@ std::tuple<op::Point<int>, op::Point<int>, op::Point<int>, op::Point<int>, std::
     op::checkE(nRead, 2, "Error, hand net resolution format (" +  FLAGS_hand_net_resolution
                + ") invalid, should be e.g., 368x368 (multiples of 16)", __LINE__, __FUNCTION__, __FILE__);
     // producerType
-    const auto producerSharedPtr = gflagsToProducer(FLAGS_image_dir, FLAGS_video, FLAGS_camera, cameraFrameSize, FLAGS_camera_fps);
+    const auto producerSharedPtr = gflagsToProducer(FLAGS_image_dir, FLAGS_video, FLAGS_camera, cameraFrameSize, FLAGS_camera_fps,
+                                                    FLAGS_image_read_ahead, FLAGS_image_decoding_threads, FLAGS_video_prefetch);
     // poseModel
     const auto poseModel = gflagToPoseModel(FLAGS_model_pose);
     // keypointScale
@@ -362,17 +462,26 @@ int opRealTimePoseDemo()
     const op::WrapperStructPose wrapperStructPose{netInputSize, outputSize, keypointScale, FLAGS_num_gpu, FLAGS_num_gpu_start,
                                                   FLAGS_num_scales, (float)FLAGS_scale_gap, gflagToRenderMode(FLAGS_render_pose), poseModel,
                                                   !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
-                                                  FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, op::ScaleMode::UnsignedChar};
+                                                  FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, op::ScaleMode::UnsignedChar,
+                                                  FLAGS_keyframe_interval, (float)FLAGS_tracking_min_ratio, (float)FLAGS_tracking_max_error,
+                                                  FLAGS_roi_full_frame_interval, (float)FLAGS_roi_padding, (float)FLAGS_motion_gate_threshold,
+                                                  FLAGS_motion_gate_max_skips, (float)FLAGS_tile_scale, (float)FLAGS_tile_overlap,
+                                                  (float)FLAGS_cascade_max_height, FLAGS_cascade_max_crops, (float)FLAGS_latency_budget,
+                                                  gflagToNetResolutions(FLAGS_latency_net_resolutions), FLAGS_face_hand_max_people,
+                                                  gflagToPersonPriority(FLAGS_face_hand_priority), gflagToPointOfInterest(FLAGS_face_hand_point),
+                                                  nullptr, FLAGS_sparse_heatmaps, FLAGS_parallel_scales, FLAGS_dynamic_net_width};
     // Face configuration (use op::WrapperStructFace{} to disable it)
     const op::WrapperStructFace wrapperStructFace{FLAGS_face, faceNetInputSize, gflagToRenderMode(FLAGS_render_face, FLAGS_render_pose),
-                                                  (float)FLAGS_alpha_face, (float)FLAGS_alpha_heatmap_face};
+                                                  (float)FLAGS_alpha_face, (float)FLAGS_alpha_heatmap_face, (float)FLAGS_face_cache_min_iou,
+                                                  FLAGS_face_cache_refresh_interval};
     // Hand configuration (use op::WrapperStructHand{} to disable it)
     const op::WrapperStructHand wrapperStructHand{FLAGS_hand, handNetInputSize, gflagToDetectionMode(FLAGS_hand_detection_mode, producerSharedPtr),
                                                   gflagToRenderMode(FLAGS_render_hand, FLAGS_render_pose), (float)FLAGS_alpha_hand,
                                                   (float)FLAGS_alpha_heatmap_hand};
     // Producer (use default to disable any input)
+    const auto roiMask = (FLAGS_roi_mask.empty() ? cv::Mat{} : op::loadImage(FLAGS_roi_mask, CV_LOAD_IMAGE_GRAYSCALE));
     const op::WrapperStructInput wrapperStructInput{producerSharedPtr, FLAGS_frame_first, FLAGS_frame_last, FLAGS_process_real_time,
-                                                    FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat};
+                                                    FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat, roiMask};
     // Consumer (comment or use default argument to disable any output)
     const op::WrapperStructOutput wrapperStructOutput{!FLAGS_no_display, !FLAGS_no_gui_verbose, FLAGS_fullscreen, FLAGS_write_keypoint,
                                                       op::stringToDataFormat(FLAGS_write_keypoint_format), FLAGS_write_keypoint_json,
@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_CORE_ARRAY_POOL_HPP
+#define OPENPOSE_CORE_ARRAY_POOL_HPP
+
+#include <vector>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    /**
+     * ArrayPool recycles the Array<T> or GpuArray<T> buffers of a stage (e.g. the net input of each frame). An array is given back to the
+     * pool as soon as no other object references it (e.g. once the Datum that kept it is released), so the steady state does not allocate
+     * any memory. Not thread-safe, the pool must be used from a single thread (the references can be released from any thread).
+     */
+    template<typename TArray>
+    class ArrayPool
+    {
+    public:
+        /**
+         * It returns an array with the desired size not referenced anywhere else. It only allocates memory if all the pooled arrays are in
+         * use or if the size changed (e.g. new net input resolution).
+         */
+        TArray get(const std::vector<int>& sizes)
+        {
+            try
+            {
+                // Free array with the same size, otherwise any free array, otherwise a new one
+                TArray* freeArray = nullptr;
+                for (auto& array : mArrays)
+                {
+                    if (array.getReferenceCount() <= 1)
+                    {
+                        freeArray = &array;
+                        if (array.getSize() == sizes)
+                            break;
+                    }
+                }
+                if (freeArray == nullptr)
+                {
+                    mArrays.emplace_back(sizes);
+                    freeArray = &mArrays.back();
+                }
+                else if (freeArray->getSize() != sizes)
+                    freeArray->reset(sizes);
+                return *freeArray;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return TArray{};
+            }
+        }
+
+    private:
+        std::vector<TArray> mArrays;
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_POOL_HPP
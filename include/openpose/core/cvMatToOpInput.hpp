@@ -6,27 +6,88 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/core/cuda.hpp>
 #include "array.hpp"
+#include "arrayPool.hpp"
 #include "point.hpp"
 #include "gpuArray.hpp"
+#include "gpuMatResizer.hpp"
 
 namespace op
 {
     class OPENPOSE_API CvMatToOpInput
     {
     public:
-        CvMatToOpInput(const Point<int>& netInputResolution, const int scaleNumber = 1, const float scaleGap = 0.25);
+        /**
+         * The net input arrays returned by format() are recycled from an internal pool as soon as no other object (e.g. a previous Datum)
+         * references them, so the Datums can keep them while the following frames are formatted.
+         * @param roiMask Optional static region of interest (1-channel 8-bit image with the input frame resolution, non-zero = useful area).
+         * If not empty, the frames are cropped to the bounding box of the mask before being resized to the net input resolution.
+         */
+        CvMatToOpInput(const Point<int>& netInputResolution, const int scaleNumber = 1, const float scaleGap = 0.25,
+                       const cv::Mat& roiMask = cv::Mat{});
 
         std::pair<Array<float>, std::vector<float>> format(const cv::Mat& cvInputData) const;
 
-		std::vector<float> format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData) const;
+        /**
+         * @param frameFlip and frameRotation Optional flip and rotation (as ProducerProperty::Flip and Rotation) of cvInputData, fused into
+         * the resize of the first scale (no intermediate flipped/rotated copy). Not compatible with the ROI mask.
+         */
+		std::vector<float> format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData, const bool frameFlip = false,
+		                          const int frameRotation = 0) const;
 
-		~CvMatToOpInput();
+        /**
+         * Same than format(gpuArray, cvInputData, frameFlip, frameRotation), but it also returns the image pyramid the scales are built
+         * from.
+         * @param inputPyramid Output, one image per scale (sorted from bigger to smaller) with the resized frame, without the net padding.
+         * Each level is resampled from the previous one, so the full resolution frame is only read once. The levels are recycled
+         * from an internal pool once the caller releases them, so they can be kept by the caller (e.g. Datum::inputPyramid).
+         * @param inputPyramidScales Output, scale of each level with respect to cvInputData (or to the bounding box of the ROI mask, if any).
+         */
+        std::vector<float> format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData, std::vector<cv::cuda::GpuMat>& inputPyramid,
+                                  std::vector<double>& inputPyramidScales, const bool frameFlip = false, const int frameRotation = 0) const;
+
+        Point<int> getNetInputSize() const;
+
+        /**
+         * Net input resolution with the height of netInputResolution and the width (multiple of 16) that fits the aspect ratio of the
+         * frames (or of the ROI mask bounding box, if any), so the padding is minimal (e.g. for portrait or 4:3 videos). The width is
+         * rounded up, so the resized frame always fills the net input height.
+         * @param inputSize Resolution of the input frames.
+         */
+        Point<int> getAspectRatioNetInputSize(const Point<int>& netInputResolution, const Point<int>& inputSize) const;
+
+        /**
+         * Bounding box of the ROI mask, i.e. the region of the frames sent to the network. Empty if no ROI mask is used.
+         */
+        cv::Rect getRoi() const;
+
+        /**
+         * It changes the net input resolution of the following frames (e.g. to adapt it to the available time budget). The pose
+         * extractor must be reshaped accordingly (e.g. PoseExtractor::setNetInputSize).
+         */
+        void setNetInputSize(const Point<int>& netInputResolution);
 
     private:
         const int mScaleNumber;
         const float mScaleGap;
-        const std::vector<int> mInputNetSize4D;
-		cv::cuda::GpuMat*		scaledInputData;
+        std::vector<int> mInputNetSize4D;
+        const cv::Size mRoiMaskSize;
+        const cv::Rect mRoi;
+        // Recycled net input buffers
+        mutable ArrayPool<Array<float>> mInputNetDataPool;
+        mutable ArrayPool<GpuArray<float>> mInputNetDataGpuPool;
+        // Padded images of format(cvInputData), reused between frames
+        mutable std::vector<cv::Mat> mFramesWithNetSize;
+        // Buffers of format(gpuArray, cvInputData), reused between frames
+        mutable std::vector<cv::cuda::GpuMat> mInputPyramid;
+        mutable std::vector<double> mInputPyramidScales;
+        // Recycled pyramids of format(gpuArray, cvInputData, inputPyramid, inputPyramidScales)
+        mutable std::vector<std::vector<cv::cuda::GpuMat>> mInputPyramidPool;
+        // Resizer of each scale, its resampling tables are constant for a video stream
+        mutable std::vector<GpuMatResizer> mResizers;
+
+        std::vector<float> formatPyramid(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData,
+                                         std::vector<cv::cuda::GpuMat>& inputPyramid, std::vector<double>& inputPyramidScales,
+                                         const bool frameFlip, const int frameRotation) const;
     };
 }
 
@@ -7,25 +7,63 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/core/cuda.hpp>
 #include "array.hpp"
+#include "arrayPool.hpp"
 #include "point.hpp"
 #include "gpuArray.hpp"
+#include "gpuMatResizer.hpp"
 
 namespace op
 {
     class OPENPOSE_API CvMatToOpOutput
     {
     public:
-        CvMatToOpOutput(const Point<int>& outputResolution, const bool generateOutput = true);
-		~CvMatToOpOutput();
+        /**
+         * The output arrays returned by format() are recycled from an internal pool as soon as no other object (e.g. a previous Datum)
+         * references them.
+         * @param frameFlip and frameRotation Optional flip and rotation (as ProducerProperty::Flip and Rotation) of the input frames,
+         * which the producer did not apply (Producer::getFrame(false)). They are fused into the GPU resize of format(), see also
+         * flipAndRotate().
+         */
+        CvMatToOpOutput(const Point<int>& outputResolution, const bool generateOutput = true, const bool frameFlip = false,
+                        const int frameRotation = 0);
 
         std::tuple<double, Array<float>> format(const cv::Mat& cvInputData) const;
 
 		void format(const cv::cuda::GpuMat& cvInputData, float& scaleInputToOutput, GpuArray<float>& outputData) const;
 
+        /**
+         * Same than format(cvInputData, scaleInputToOutput, outputData), but it also returns the resized uchar frame (without the output
+         * padding), e.g. to build the net input from it instead of from the full resolution frame (WCvMatToOpInputOutput). It shares
+         * the cvInputData memory if no resize is required, and it is empty if the output is not generated.
+         */
+        void format(const cv::cuda::GpuMat& cvInputData, float& scaleInputToOutput, GpuArray<float>& outputData,
+                    cv::cuda::GpuMat& outputImage) const;
+
+        /**
+         * It replaces cvInputData (not flipped nor rotated yet) by its flipped and rotated version (e.g. for the face and hand crops,
+         * which read it at full resolution). If outputImage (from format()) has the input resolution, it is reused (no extra pass). It
+         * does nothing if neither frameFlip nor frameRotation were set.
+         */
+        void flipAndRotate(cv::cuda::GpuMat& cvInputData, const cv::cuda::GpuMat& outputImage) const;
+
+        bool getFrameFlip() const;
+
+        int getFrameRotation() const;
+
     private:
         const bool mGenerateOutput;
         const std::vector<int> mOutputSize3D;
-		cv::cuda::GpuMat* scaledImage;
+        const bool mFrameFlip;
+        const int mFrameRotation;
+        // Recycled output buffers
+        mutable ArrayPool<Array<float>> mOutputDataPool;
+        mutable ArrayPool<GpuArray<float>> mOutputDataGpuPool;
+        // Resized frame of format(cvInputData), reused between frames
+        mutable cv::Mat mFrameWithOutputSize;
+        // Recycled flipped and rotated input frames (flipAndRotate)
+        mutable std::vector<cv::cuda::GpuMat> mFlippedAndRotatedInputs;
+        // Its resampling tables are constant for a video stream
+        mutable GpuMatResizer mResizer;
     };
 }
 
@@ -2,8 +2,10 @@
 #define OPENPOSE_CORE_DATUM_HPP
 
 #include <array>
+#include <chrono>
 #include <memory> // std::shared_ptr
 #include <string>
+#include <vector>
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <opencv2/core/cuda.hpp> // cv::cuda::GpuMat
 #include "array.hpp"
@@ -41,6 +43,16 @@ namespace op
          */
         GpuArray<float> inputNetData;
 
+        /**
+         * Image pyramid of cvInputData used to build inputNetData, one level per scale (sorted from bigger to smaller) without the net
+         * padding. Each level is resampled from the previous one. Other modules can crop from them instead of from the full resolution
+         * image (e.g. the face and hand extractors).
+         * It is empty if not required (i.e. face and hand disabled) or if a static ROI mask is used.
+         */
+        std::vector<cv::cuda::GpuMat> inputPyramid;
+
+        std::vector<double> inputPyramidScales; /**< Scale of each inputPyramid level with respect to cvInputData. */
+
         /**
          * Rendered image in Array<float> format.
          * It consists of a blending of the inputNetData and the pose/body part(s) heatmap/PAF(s).
@@ -110,10 +122,36 @@ namespace op
 
         float scaleNetToOutput; /**< Scale ratio between the net output and the final output Datum::cvOutputData. */
 
+        /**
+         * Scale ratio between the original producer frame (e.g. the image file) and the input Datum::cvInputData. It is lower than 1 if the
+         * producer decoded it at a reduced resolution (e.g. ImageDirectoryReader::setReducedDecoding), so that the keypoints are still
+         * rescaled to the original frame coordinates (KeypointScaler).
+         */
+        float scaleProducerToInput;
+
         std::vector<float> scaleRatios; /**< Scale ratios between each scale (e.g. flag `num_scales`). Used to resize the different scales. */
 
         std::pair<int, std::string> elementRendered; /**< Pair with the element key id POSE_BODY_PART_MAPPING on `pose/poseParameters.hpp` and its mapped value (e.g. 1 and "Neck"). */
 
+        /**
+         * Whether the keypoint inference was skipped for this frame (e.g. by the motion gate, WMotionGate), i.e. poseKeypoints, faceKeypoints
+         * and handKeypoints are the ones of the last processed frame.
+         */
+        bool inferenceSkipped;
+
+        /**
+         * Net input resolution used for this frame. It might change at runtime (e.g. with the latency budget controller,
+         * NetResolutionController, or with the dynamic net input width, CvMatToOpInput::getAspectRatioNetInputSize).
+         */
+        Point<int> netInputSize;
+
+        /**
+         * Time at which the frame was requested from the producer (DatumProducer), or at which it entered the preprocessing
+         * (WCvMatToOpInputOutput) if no producer set it (e.g. frames pushed by the user). Used to measure the end-to-end latency of the
+         * latency budget controller (NetResolutionController).
+         */
+        std::chrono::high_resolution_clock::time_point timestamp;
+
 	
 
         // -------------------------------------------------- Functions -------------------------------------------------- //
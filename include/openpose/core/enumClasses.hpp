@@ -34,6 +34,13 @@ namespace op
         Cpu,
         Gpu,
     };
+
+    enum class PersonPriority : unsigned char
+    {
+        Area,       // Biggest people first
+        Distance,   // People closest to a point of interest first
+        Callback,   // Highest user-defined priority first
+    };
 }
 
 #endif // OPENPOSE_CORE_ENUM_CLASSES_HPP
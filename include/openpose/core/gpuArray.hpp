@@ -184,6 +184,15 @@ namespace op
          */
         size_t getVolume(const int indexA, const int indexB) const;
 
+        /**
+         * Return the number of objects sharing this data (i.e. this one and its `fast copies`). E.g. 1 if no other object references it.
+         * @return The number of references. 0 if no memory is allocated.
+         */
+        inline long getReferenceCount() const
+        {
+            return spData.use_count();
+        }
+
 
 
         // -------------------------------------------------- Data Access Functions And Operators -------------------------------------------------- //
@@ -0,0 +1,42 @@
+#ifndef OPENPOSE_CORE_GPU_MAT_RESIZER_HPP
+#define OPENPOSE_CORE_GPU_MAT_RESIZER_HPP
+
+#include <array>
+#include <opencv2/core/core.hpp> // cv::Size
+#include <opencv2/core/cuda.hpp> // cv::cuda::GpuMat
+#include <openpose/utilities/macros.hpp>
+#include "gpuArray.hpp"
+#include "point.hpp"
+
+namespace op
+{
+    /**
+     * GpuMatResizer resizes the frames of a stream into a (letterboxed) net input or output float blob with 1 fused GPU pass
+     * (resizeGpuMatToFloatPtr). The resampling tables are cached between frames, they are only recomputed if the source or target
+     * resolution change (i.e. once for a video stream with constant resolution).
+     */
+    class OPENPOSE_API GpuMatResizer
+    {
+    public:
+        explicit GpuMatResizer();
+
+        /**
+         * @param floatImage Output float blob (C x floatImageSize.y x floatImageSize.x at floatImage + offset). The source is resized into
+         * its top-left targetSize region and the rest (padding) is set to black.
+         * @param target Output, resized uchar image (targetSize). Not written if nullptr.
+         * @param flip and rotation Optional flip and rotation of the source (as ProducerProperty::Flip and Rotation), fused into the
+         * resampling tables (no intermediate flipped/rotated copy). targetSize, floatImage and target are then in the flipped and rotated
+         * coordinates.
+         */
+        void resize(float* floatImage, cv::cuda::GpuMat* target, const cv::cuda::GpuMat& source, const cv::Size& targetSize,
+                    const Point<int>& floatImageSize, const bool normalize, const unsigned long offset = 0, const bool flip = false,
+                    const int rotation = 0);
+
+    private:
+        std::array<int, 6> mSizes;
+        std::array<GpuArray<int>, 2> mIndexes;
+        std::array<GpuArray<float>, 2> mWeights;
+    };
+}
+
+#endif // OPENPOSE_CORE_GPU_MAT_RESIZER_HPP
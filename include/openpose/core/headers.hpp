@@ -3,24 +3,31 @@
 
 // core module
 #include "array.hpp"
+#include "arrayPool.hpp"
 #include "cvMatToOpInput.hpp"
 #include "cvMatToOpOutput.hpp"
 #include "datum.hpp"
+#include "gpuMatResizer.hpp"
 #include "enumClasses.hpp"
 #include "keypointScaler.hpp"
+#include "motionGate.hpp"
 #include "net.hpp"
 #include "netCaffe.hpp"
+#include "netResolutionController.hpp"
 #include "nmsBase.hpp"
 #include "nmsCaffe.hpp"
 #include "opOutputToCvMat.hpp"
+#include "personSelector.hpp"
 #include "point.hpp"
 #include "rectangle.hpp"
 #include "renderer.hpp"
 #include "resizeAndMergeBase.hpp"
 #include "resizeAndMergeCaffe.hpp"
 #include "wCvMatToOpInput.hpp"
+#include "wCvMatToOpInputOutput.hpp"
 #include "wCvMatToOpOutput.hpp"
 #include "wKeypointScaler.hpp"
+#include "wMotionGate.hpp"
 #include "wOpOutputToCvMat.hpp"
 
 #endif // OPENPOSE_CORE_HEADERS_HPP
@@ -13,9 +13,11 @@ namespace op
     public:
         explicit KeypointScaler(const ScaleMode scaleMode);
 
-        void scale(Array<float>& arrayToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize) const;
+        void scale(Array<float>& arrayToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize,
+                   const float scaleProducerToInput = 1.f) const;
 
-        void scale(std::vector<Array<float>>& arraysToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize) const;
+        void scale(std::vector<Array<float>>& arraysToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize,
+                   const float scaleProducerToInput = 1.f) const;
 
     private:
         const ScaleMode mScaleMode;
@@ -0,0 +1,50 @@
+#ifndef OPENPOSE_CORE_MOTION_GATE_HPP
+#define OPENPOSE_CORE_MOTION_GATE_HPP
+
+#include <atomic>
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/utilities/macros.hpp>
+
+namespace op
+{
+    /**
+     * MotionGate decides whether a frame is (almost) identical to the last processed one, in which case the keypoint inference can be
+     * skipped and its results reused. The change metric is the mean absolute difference (range [0, 255]) of a small grayscale version of
+     * both frames.
+     * Note: skip() is not thread-safe, each stream (or GPU) must have its own MotionGate. The counters can be read from any thread.
+     */
+    class OPENPOSE_API MotionGate
+    {
+    public:
+        /**
+         * @param threshold Maximum mean absolute pixel difference (range [0, 255]) to consider a frame static.
+         * @param maxConsecutiveSkips Maximum number of consecutive skipped frames. After it, the next frame is always processed.
+         * @param gateWidth Width of the downscaled frames that are compared (height keeps the aspect ratio).
+         */
+        explicit MotionGate(const float threshold, const int maxConsecutiveSkips, const int gateWidth = 64);
+
+        /**
+         * It returns true if the frame can be skipped, and false if it must be processed (and it becomes the new reference frame).
+         */
+        bool skip(const cv::Mat& cvInputData);
+
+        unsigned long long getSkippedFrames() const;
+
+        unsigned long long getProcessedFrames() const;
+
+    private:
+        const float mThreshold;
+        const int mMaxConsecutiveSkips;
+        const int mGateWidth;
+        int mConsecutiveSkips;
+        std::atomic<unsigned long long> mSkippedFrames;
+        std::atomic<unsigned long long> mProcessedFrames;
+        cv::Mat mReferenceFrame;
+        cv::Mat mCurrentFrame;
+        cv::Mat mCurrentGray;
+
+        DELETE_COPY(MotionGate);
+    };
+}
+
+#endif // OPENPOSE_CORE_MOTION_GATE_HPP
@@ -3,8 +3,12 @@
 #define OPENPOSE_CORE_NET_CAFFE_HPP
 
 #include <array>
+#include <condition_variable>
 #include <memory> // std::shared_ptr
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <caffe/net.hpp>
 #include <openpose/utilities/macros.hpp>
 #include "net.hpp"
@@ -14,13 +18,26 @@ namespace op
     class OPENPOSE_API NetCaffe : public Net
     {
     public:
+        /**
+         * @param parallelScales If true and netInputSize4D[0] > 1 (i.e. several scales), each scale runs on the CPU on its own thread with
+         * its own net instance (all sharing the same weights) rather than as a single batch. The outputs are concatenated into the same
+         * output blob, so it is transparent for the post-processing.
+         */
         NetCaffe(const std::array<int, 4>& netInputSize4D, const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId = 0,
-                 const std::string& lastBlobName = "net_output");
+                 const std::string& lastBlobName = "net_output", const bool parallelScales = false);
 
         virtual ~NetCaffe();
 
         void initializationOnThread();
 
+        /**
+         * Reshape the input blob (and the whole net accordingly) to a new 4-D size (e.g. a different batch size).
+         * Caffe only reallocates memory if the new size is bigger than any previous one, so it is cheap to call it with a varying batch size.
+         * It must be called from the same thread than initializationOnThread(). With parallelScales, changing the number of scales
+         * (netInputSize4D[0]) rebuilds the nets and their threads (as initializationOnThread()), so getOutputBlob() must be called again.
+         */
+        void reshape(const std::array<int, 4>& netInputSize4D);
+
         // Alternative a) getInputDataCpuPtr or getInputDataGpuPtr + forwardPass
         float* getInputDataCpuPtr() const;
 
@@ -34,14 +51,34 @@ namespace op
     private:
         // Init with constructor
         const int mGpuId;
-        const std::array<int, 4> mNetInputSize4D;
-        const unsigned long mNetInputMemory;
+        std::array<int, 4> mNetInputSize4D;
+        unsigned long mNetInputMemory;
         const std::string mCaffeProto;
         const std::string mCaffeTrainedModel;
         const std::string mLastBlobName;
+        const bool mParallelScales;
         // Init with thread
         std::unique_ptr<caffe::Net<float>> upCaffeNet;
         boost::shared_ptr<caffe::Blob<float>> spOutputBlob;
+        // Parallel scales: upCaffeNet runs the 1st scale, upScaleNets the remaining ones
+        std::vector<std::unique_ptr<caffe::Net<float>>> upScaleNets;
+        std::unique_ptr<caffe::Blob<float>> upInputBlob;
+        std::vector<std::thread> mScaleThreads;
+        mutable std::mutex mScaleMutex;
+        mutable std::condition_variable mScaleConditionVariable;
+        mutable unsigned long long mScaleJob;
+        mutable int mScalesPending;
+        bool mScaleThreadsStop;
+
+        bool parallelScales() const;
+
+        void reshapeParallelScales();
+
+        void forwardPassParallelScales() const;
+
+        void scaleThreadLoop(const int scaleNet);
+
+        void stopScaleThreads();
 
         DELETE_COPY(NetCaffe);
     };
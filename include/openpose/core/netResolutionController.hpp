@@ -0,0 +1,60 @@
+#ifndef OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <openpose/utilities/macros.hpp>
+#include "point.hpp"
+
+namespace op
+{
+    /**
+     * NetResolutionController keeps the pose latency per frame within a budget by stepping the net input resolution among a list of them.
+     * The latency is averaged over `framesPerStep` frames. If the average exceeds the budget, it steps down to the next lower resolution.
+     * It only steps up if the latency predicted for the higher resolution (proportional to its area) is below `(1 - hysteresis)` times the
+     * budget, which avoids oscillating between 2 resolutions.
+     * The latency is the end-to-end one reported by WPoseExtractor: from Datum::timestamp (the producer, or the preprocessing if no
+     * producer stamped the frame) to the pose output, so it includes the decoding, the queueing, the preprocessing and the body network.
+     * The stages after the pose extraction (e.g. face, hand, rendering and display) are not included.
+     * Thread-safe: CvMatToOpInput reads the resolution and each pose worker (one per GPU) reports its latencies.
+     */
+    class OPENPOSE_API NetResolutionController
+    {
+    public:
+        /**
+         * @param netInputSizes Available net input resolutions (multiples of 16), sorted from the highest to the lowest one.
+         * @param initialNetInputSize Starting resolution, it must be one of netInputSizes.
+         * @param latencyBudgetMs Target maximum latency per frame (in milliseconds).
+         * @param dynamicNetInputWidth Whether the net input width of each frame is adapted to its aspect ratio (only the height of the
+         * selected resolution is kept), in which case the heights of netInputSizes must be different.
+         */
+        NetResolutionController(const std::vector<Point<int>>& netInputSizes, const Point<int>& initialNetInputSize,
+                                const double latencyBudgetMs, const bool dynamicNetInputWidth = false, const double hysteresis = 0.2,
+                                const int framesPerStep = 10);
+
+        Point<int> getNetInputSize() const;
+
+        /**
+         * It adds the latency of a processed frame and, every `framesPerStep` frames, it steps the resolution if required.
+         * @param netInputSize Net input resolution of that frame (Datum::netInputSize). Frames formatted before the last resolution change
+         * (i.e. still queued with the previous resolution) are ignored, so each window only measures the current resolution.
+         */
+        void report(const double latencyMs, const Point<int>& netInputSize);
+
+    private:
+        const std::vector<Point<int>> mNetInputSizes;
+        const double mLatencyBudgetMs;
+        const bool mDynamicNetInputWidth;
+        const double mHysteresis;
+        const int mFramesPerStep;
+        std::atomic<int> mNetInputSizeIndex;
+        std::mutex mReportMutex;
+        double mAccumulatedLatencyMs;
+        int mAccumulatedFrames;
+
+        DELETE_COPY(NetResolutionController);
+    };
+}
+
+#endif // OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
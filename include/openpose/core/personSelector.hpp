@@ -0,0 +1,60 @@
+#ifndef OPENPOSE_CORE_PERSON_SELECTOR_HPP
+#define OPENPOSE_CORE_PERSON_SELECTOR_HPP
+
+#include <functional> // std::function
+#include <vector>
+#include <openpose/utilities/macros.hpp>
+#include "array.hpp"
+#include "enumClasses.hpp"
+#include "point.hpp"
+
+namespace op
+{
+    /**
+     * Score given to the keypoints of the people that were not selected by a PersonSelector (i.e. not evaluated), as opposed to a score of
+     * 0 (i.e. evaluated but not found).
+     */
+    const auto KEYPOINT_NOT_EVALUATED_SCORE = -1.f;
+
+    /**
+     * PersonSelector bounds the cost of the face and hand networks in crowded frames by only selecting the top `maxPeople` people of each
+     * frame, ranked by area (see getBiggestPerson), distance to a point of interest, or a user callback.
+     */
+    class OPENPOSE_API PersonSelector
+    {
+    public:
+        /**
+         * User-defined priority of a person, the higher the sooner it is selected.
+         */
+        typedef std::function<float(const Array<float>& poseKeypoints, const int person)> PriorityFunction;
+
+        /**
+         * @param maxPeople Maximum number of selected people per frame.
+         * @param pointOfInterest Only used if personPriority == PersonPriority::Distance, in the same coordinates than poseKeypoints (i.e.
+         * output resolution).
+         * @param priorityFunction Only used (and required) if personPriority == PersonPriority::Callback.
+         */
+        PersonSelector(const int maxPeople, const PersonPriority personPriority = PersonPriority::Area,
+                       const Point<float>& pointOfInterest = Point<float>{}, const PriorityFunction& priorityFunction = nullptr);
+
+        /**
+         * Whether each person of poseKeypoints is selected.
+         */
+        std::vector<bool> select(const Array<float>& poseKeypoints) const;
+
+        /**
+         * It sets the score of all the keypoints of the non-selected people to KEYPOINT_NOT_EVALUATED_SCORE.
+         */
+        void markNotEvaluated(Array<float>& keypoints, const std::vector<bool>& selectedPeople) const;
+
+    private:
+        const int mMaxPeople;
+        const PersonPriority mPersonPriority;
+        const Point<float> mPointOfInterest;
+        const PriorityFunction mPriorityFunction;
+
+        DELETE_COPY(PersonSelector);
+    };
+}
+
+#endif // OPENPOSE_CORE_PERSON_SELECTOR_HPP
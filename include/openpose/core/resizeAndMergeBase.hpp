@@ -13,6 +13,50 @@ namespace op
     template <typename T>
     void resizeAndMergeGpu(T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
                            const std::vector<T>& scaleRatios = {1});
+
+    /**
+     * Tiled version of resizeAndMergeGpu: sourcePtr stacks the scales of several overlapping tiles of a bigger frame (tile-major, i.e.
+     * sourceSize[0] = tileOffsets.size() * scaleRatios.size()), and targetPtr is the merged heat map of the whole frame (targetSize[0]
+     * must be 1). Each target pixel is the bicubic interpolation of every tile and scale covering it (at the resolution of the first
+     * scale of the tiles, `factor` times the source one), so the peaks and PAFs of the overlapping areas are merged before NMS and the
+     * body part connection. The tiles are averaged with weights that fade towards their borders (where the network misses context).
+     * @param tileParametersPtr GPU buffer of at least 2 * tileOffsets.size() + scaleRatios.size() elements, kept by the caller between
+     * frames.
+     * @param tileOffsets Top-left corner (x, y) of each tile, in target pixels.
+     * @param tileSize Size (width, height) of the tiles, in target pixels.
+     */
+    template <typename T>
+    void resizeAndMergeTilesGpu(T* targetPtr, T* tileParametersPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+                                const std::array<int, 4>& sourceSize, const std::vector<std::array<T, 2>>& tileOffsets,
+                                const std::array<T, 2>& tileSize, const T factor, const std::vector<T>& scaleRatios = {1});
+
+    /**
+     * Sparse version of resizeAndMergeGpu (single scale only). The first `numberSparseChannels` channels are split into tiles,
+     * and the pixels whose tile (and its 8 neighbors) cannot exceed `threshold` (see resizeAndMergeMaxBoundGpu) are set to 0
+     * instead of being interpolated. The peaks found by NMS with that threshold (including their sub-pixel refinement) are the
+     * same than in the dense version. The remaining channels are resized densely. NMS is not affected (it still reads every
+     * target pixel, the cold ones are just 0).
+     * @param tileMaskPtr GPU buffer of at least getResizeAndMergeSparseMaskSize(sourceSize, numberSparseChannels) elements, kept
+     * by the caller between frames.
+     */
+    template <typename T>
+    void resizeAndMergeSparseGpu(T* targetPtr, unsigned char* tileMaskPtr, const T* const sourcePtr,
+                                 const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                 const int numberSparseChannels, const T threshold);
+
+    /**
+     * Number of tiles (i.e. tile mask elements) of resizeAndMergeSparseGpu.
+     */
+    int getResizeAndMergeSparseMaskSize(const std::array<int, 4>& sourceSize, const int numberSparseChannels);
+
+    /**
+     * Upper bound of the values that resizeAndMergeGpu would output for the first `numberChannels` channels of sourcePtr,
+     * without computing it. The bicubic (Catmull-Rom) weights add up to at most 1.4453125 (positive ones) and 0.4453125
+     * (negative ones) in 2-D (including the borders, where the interpolation offset can reach -0.5), and merging scales
+     * averages them. E.g. if it is not greater than the NMS threshold, there cannot be any peak.
+     */
+    template <typename T>
+    T resizeAndMergeMaxBoundGpu(const T* const sourcePtr, const std::array<int, 4>& sourceSize, const int numberChannels);
 }
 
 #endif // OPENPOSE_CORE_RESIZE_AND_MERGE_BASE_HPP
@@ -6,6 +6,7 @@
 #include <vector>
 #include <caffe/blob.hpp>
 #include <openpose/utilities/macros.hpp>
+#include "gpuArray.hpp"
 
 namespace op
 {
@@ -23,10 +24,29 @@ namespace op
         virtual void Reshape(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top,
                              const float factor, const bool mergeFirstDimension = true);
 
+        /**
+         * Reshape of the tiled mode (see setTiles): the top blob is the heat map of the whole frame, i.e. {1, channels, topHeight,
+         * topWidth}.
+         */
+        virtual void ReshapeTiles(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top, const int topWidth,
+                                  const int topHeight);
+
         virtual inline const char* type() const { return "ResizeAndMerge"; }
 
         void setScaleRatios(const std::vector<T>& scaleRatios);
 
+        /**
+         * Tiled mode (see resizeAndMergeTilesGpu), the bottom blob contains the scales of several tiles of the same frame. Empty
+         * tileOffsets disables it.
+         * @param factor Resolution of the first scale of the tiles relative to the bottom one.
+         */
+        void setTiles(const std::vector<std::array<T, 2>>& tileOffsets, const std::array<T, 2>& tileSize, const T factor);
+
+        /**
+         * Sparse mode (see resizeAndMergeSparseGpu), only applied with a single scale and without tiles. 0 sparse channels disables it.
+         */
+        void setSparse(const int numberSparseChannels, const T threshold);
+
         virtual void Forward_cpu(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top);
 
         virtual void Forward_gpu(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top);
@@ -39,6 +59,15 @@ namespace op
 
     private:
         std::vector<T> mScaleRatios;
+        int mNumberSparseChannels;
+        T mSparseThreshold;
+        // Tile mask of the sparse mode, kept between frames (only reallocated if the number of tiles grows)
+        GpuArray<unsigned char> mTileMask;
+        std::vector<std::array<T, 2>> mTileOffsets;
+        std::array<T, 2> mTileSize;
+        T mTileFactor;
+        // Tile offsets and scale ratios of the tiled mode in GPU memory (only reallocated if they grow)
+        GpuArray<T> mTileParameters;
         std::array<int, 4> mBottomSize;
         std::array<int, 4> mTopSize;
 
@@ -4,6 +4,7 @@
 #include <memory> // std::shared_ptr
 #include <openpose/thread/worker.hpp>
 #include "cvMatToOpInput.hpp"
+#include "netResolutionController.hpp"
 
 namespace op
 {
@@ -11,7 +12,15 @@ namespace op
     class WCvMatToOpInput : public Worker<TDatums>
     {
     public:
-        explicit WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput);
+        /**
+         * @param netResolutionController Optional, if not nullptr, the net input resolution of each frame is the one it selects.
+         * @param inputPyramid Whether to keep the image pyramid of each frame in Datum::inputPyramid (e.g. for the face and hand crops).
+         * @param dynamicNetInputWidth Whether to adapt the net input width of each frame to its aspect ratio, keeping the net input height
+         * (CvMatToOpInput::getAspectRatioNetInputSize).
+         */
+        explicit WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput,
+                                 const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr,
+                                 const bool inputPyramid = false, const bool dynamicNetInputWidth = false);
 
         void initializationOnThread();
 
@@ -19,6 +28,10 @@ namespace op
 
     private:
         const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        const bool mInputPyramid;
+        const bool mDynamicNetInputWidth;
+        const Point<int> mNetInputSize;
 		GpuArray<float> inputNetData;
 
         DELETE_COPY(WCvMatToOpInput);
@@ -38,8 +51,14 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WCvMatToOpInput<TDatums>::WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput) :
-        spCvMatToOpInput{cvMatToOpInput}
+    WCvMatToOpInput<TDatums>::WCvMatToOpInput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput,
+                                              const std::shared_ptr<NetResolutionController>& netResolutionController,
+                                              const bool inputPyramid, const bool dynamicNetInputWidth) :
+        spCvMatToOpInput{cvMatToOpInput},
+        spNetResolutionController{netResolutionController},
+        mInputPyramid{inputPyramid},
+        mDynamicNetInputWidth{dynamicNetInputWidth},
+        mNetInputSize{cvMatToOpInput->getNetInputSize()}
     {
     }
 
@@ -59,12 +78,26 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Net input resolution selected by the latency budget controller
+                const auto baseNetInputSize = (spNetResolutionController != nullptr
+                                               ? spNetResolutionController->getNetInputSize() : mNetInputSize);
+                if (spNetResolutionController != nullptr)
+                    spCvMatToOpInput->setNetInputSize(baseNetInputSize);
                 // cv::Mat -> float*
                 /*for (auto& tDatum : *tDatums)
                     std::tie(tDatum.inputNetData, tDatum.scaleRatios) = spCvMatToOpInput->format(tDatum.cvInputData);*/
 				for (auto& tDatum : *tDatums) {
-					tDatum.scaleRatios = spCvMatToOpInput->format(inputNetData, tDatum.cvInputData);
+					// Net input width adapted to the frame aspect ratio
+					if (mDynamicNetInputWidth)
+						spCvMatToOpInput->setNetInputSize(spCvMatToOpInput->getAspectRatioNetInputSize(
+							baseNetInputSize, Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows}));
+					if (mInputPyramid)
+						tDatum.scaleRatios = spCvMatToOpInput->format(inputNetData, tDatum.cvInputData, tDatum.inputPyramid,
+						                                              tDatum.inputPyramidScales);
+					else
+						tDatum.scaleRatios = spCvMatToOpInput->format(inputNetData, tDatum.cvInputData);
 					tDatum.inputNetData = inputNetData;
+					tDatum.netInputSize = spCvMatToOpInput->getNetInputSize();
 				}
 					
 				
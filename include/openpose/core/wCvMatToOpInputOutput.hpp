@@ -0,0 +1,154 @@
+#ifndef OPENPOSE_CORE_W_CV_MAT_TO_OP_INPUT_OUTPUT_HPP
+#define OPENPOSE_CORE_W_CV_MAT_TO_OP_INPUT_OUTPUT_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "cvMatToOpInput.hpp"
+#include "cvMatToOpOutput.hpp"
+#include "gpuArray.hpp"
+#include "netResolutionController.hpp"
+
+namespace op
+{
+    /**
+     * Single preprocessing stage, replacing WCvMatToOpInput followed by WCvMatToOpOutput. Both the output frame and the net input are
+     * resized from Datum::cvInputData (the net input is never chained off the rounded uint8 output frame, so its accuracy matches the
+     * WCvMatToOpInput one). If the CvMatToOpOutput has a frame flip or rotation, Datum::cvInputData is replaced by its flipped and rotated
+     * version (CvMatToOpOutput::flipAndRotate) for the following stages, while the net input is resized from the unrotated frame, with the
+     * flip and rotation fused into its resampling tables (unless a ROI mask is used).
+     */
+    template<typename TDatums>
+    class WCvMatToOpInputOutput : public Worker<TDatums>
+    {
+    public:
+        /**
+         * @param netResolutionController Optional, if not nullptr, the net input resolution of each frame is the one it selects.
+         * @param inputPyramid Whether to keep the image pyramid of each frame in Datum::inputPyramid (e.g. for the face and hand crops).
+         * @param dynamicNetInputWidth Whether to adapt the net input width of each frame to its aspect ratio, keeping the net input height
+         * (CvMatToOpInput::getAspectRatioNetInputSize). The pose extractor must be reshaped accordingly (Datum::netInputSize).
+         */
+        explicit WCvMatToOpInputOutput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput,
+                                       const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput,
+                                       const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr,
+                                       const bool inputPyramid = false, const bool dynamicNetInputWidth = false);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        const std::shared_ptr<CvMatToOpOutput> spCvMatToOpOutput;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        const bool mInputPyramid;
+        const bool mDynamicNetInputWidth;
+        const Point<int> mNetInputSize;
+        GpuArray<float> mInputNetData;
+        GpuArray<float> mOutputData;
+        cv::cuda::GpuMat mOutputImage;
+
+        DELETE_COPY(WCvMatToOpInputOutput);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <chrono>
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WCvMatToOpInputOutput<TDatums>::WCvMatToOpInputOutput(const std::shared_ptr<CvMatToOpInput>& cvMatToOpInput,
+                                                          const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput,
+                                                          const std::shared_ptr<NetResolutionController>& netResolutionController,
+                                                          const bool inputPyramid, const bool dynamicNetInputWidth) :
+        spCvMatToOpInput{cvMatToOpInput},
+        spCvMatToOpOutput{cvMatToOpOutput},
+        spNetResolutionController{netResolutionController},
+        mInputPyramid{inputPyramid},
+        mDynamicNetInputWidth{dynamicNetInputWidth},
+        mNetInputSize{cvMatToOpInput->getNetInputSize()}
+    {
+    }
+
+    template<typename TDatums>
+    void WCvMatToOpInputOutput<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WCvMatToOpInputOutput<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Net input resolution selected by the latency budget controller
+                const auto baseNetInputSize = (spNetResolutionController != nullptr
+                                               ? spNetResolutionController->getNetInputSize() : mNetInputSize);
+                if (spNetResolutionController != nullptr)
+                    spCvMatToOpInput->setNetInputSize(baseNetInputSize);
+                const auto noRoi = (spCvMatToOpInput->getRoi().area() == 0);
+                for (auto& tDatum : *tDatums)
+                {
+                    // Start of the end-to-end latency if no producer stamped the frame (e.g. frames pushed by the user)
+                    if (tDatum.timestamp.time_since_epoch().count() == 0)
+                        tDatum.timestamp = std::chrono::high_resolution_clock::now();
+                    // Output frame
+                    spCvMatToOpOutput->format(tDatum.cvInputData, tDatum.scaleInputToOutput, mOutputData, mOutputImage);
+                    tDatum.outputData = mOutputData;
+                    // Flip and rotation (if not applied by the producer) - The following stages see the flipped and rotated frame (e.g.
+                    // the face and hand crops, or any user worker reading Datum::cvInputData)
+                    const auto unrotatedInputData = tDatum.cvInputData;
+                    spCvMatToOpOutput->flipAndRotate(tDatum.cvInputData, mOutputImage);
+                    // Net input width adapted to the frame aspect ratio
+                    if (mDynamicNetInputWidth)
+                        spCvMatToOpInput->setNetInputSize(spCvMatToOpInput->getAspectRatioNetInputSize(
+                            baseNetInputSize, Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows}));
+                    const auto netInputSize = spCvMatToOpInput->getNetInputSize();
+                    // Net input - From the unrotated frame with the flip and rotation fused into the resize (rather than reading the
+                    // flipped and rotated copy), unless the ROI mask (in flipped and rotated coordinates) is used
+                    const auto fuseFlipAndRotation = (noRoi && unrotatedInputData.data != tDatum.cvInputData.data);
+                    const auto& netSource = (fuseFlipAndRotation ? unrotatedInputData : tDatum.cvInputData);
+                    const auto netFlip = (fuseFlipAndRotation && spCvMatToOpOutput->getFrameFlip());
+                    const auto netRotation = (fuseFlipAndRotation ? spCvMatToOpOutput->getFrameRotation() : 0);
+                    if (mInputPyramid)
+                        tDatum.scaleRatios = spCvMatToOpInput->format(mInputNetData, netSource, tDatum.inputPyramid,
+                                                                      tDatum.inputPyramidScales, netFlip, netRotation);
+                    else
+                        tDatum.scaleRatios = spCvMatToOpInput->format(mInputNetData, netSource, netFlip, netRotation);
+                    tDatum.inputNetData = mInputNetData;
+                    tDatum.netInputSize = netInputSize;
+                    // If it shares the cvInputData memory (no resize), it must not be reused as buffer for the next frames
+                    if (mOutputImage.data == tDatum.cvInputData.data)
+                        mOutputImage.release();
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WCvMatToOpInputOutput);
+}
+
+#endif // OPENPOSE_CORE_W_CV_MAT_TO_OP_INPUT_OUTPUT_HPP
@@ -0,0 +1,91 @@
+#ifndef OPENPOSE_CORE_W_MOTION_GATE_HPP
+#define OPENPOSE_CORE_W_MOTION_GATE_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "motionGate.hpp"
+
+namespace op
+{
+    /**
+     * It sets Datum::inferenceSkipped for each frame. It must be placed before the pose extractor worker, which (as well as the face and hand
+     * extractor workers) reuses the last results instead of running the network on skipped frames.
+     */
+    template<typename TDatums>
+    class WMotionGate : public Worker<TDatums>
+    {
+    public:
+        explicit WMotionGate(const std::shared_ptr<MotionGate>& motionGate);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<MotionGate> spMotionGate;
+
+        DELETE_COPY(WMotionGate);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WMotionGate<TDatums>::WMotionGate(const std::shared_ptr<MotionGate>& motionGate) :
+        spMotionGate{motionGate}
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Frame difference gate (cvOutputData still contains the original CPU frame at this point)
+                for (auto& tDatum : *tDatums)
+                    tDatum.inferenceSkipped = (!tDatum.cvOutputData.empty() && spMotionGate->skip(tDatum.cvOutputData));
+                // Skipped frames counter
+                const auto skippedFrames = spMotionGate->getSkippedFrames();
+                const auto totalFrames = skippedFrames + spMotionGate->getProcessedFrames();
+                if (totalFrames % Profiler::DEFAULT_X == 0)
+                    log("Motion gate: " + std::to_string(skippedFrames) + " of " + std::to_string(totalFrames) + " frames skipped.",
+                        Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WMotionGate);
+}
+
+#endif // OPENPOSE_CORE_W_MOTION_GATE_HPP
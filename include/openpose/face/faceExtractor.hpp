@@ -25,7 +25,12 @@ namespace op
         void initializationOnThread();
 
         void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::Mat& cvInputData, const float scaleInputToOutput);
-        void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput);
+        /**
+         * @param inputPyramid Optional (e.g. Datum::inputPyramid), the faces that are downscaled are cropped from its smallest level with
+         * enough resolution (antialiased and smaller reads) rather than from cvInputData.
+         */
+        void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput,
+                         const std::vector<cv::cuda::GpuMat>& inputPyramid = {}, const std::vector<double>& inputPyramidScales = {});
 
         Array<float> getFaceKeypoints() const;
 
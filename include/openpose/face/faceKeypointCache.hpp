@@ -0,0 +1,51 @@
+#ifndef OPENPOSE_FACE_FACE_KEYPOINT_CACHE_HPP
+#define OPENPOSE_FACE_FACE_KEYPOINT_CACHE_HPP
+
+#include <vector>
+#include <openpose/core/array.hpp>
+#include <openpose/core/rectangle.hpp>
+#include <openpose/utilities/macros.hpp>
+
+namespace op
+{
+    /**
+     * FaceKeypointCache avoids running the face network on (nearly) static faces. Each face rectangle is matched (by IoU) against the
+     * ones of the previous frame. If it barely moved, the previous keypoints are reused, shifted and scaled from the previous rectangle
+     * into the new one. Each face is evaluated again after at most `refreshInterval` consecutive reuses.
+     */
+    class OPENPOSE_API FaceKeypointCache
+    {
+    public:
+        /**
+         * @param minIou Minimum IoU between the current and the previous rectangle of a face to reuse its keypoints.
+         * @param refreshInterval Maximum number of consecutive frames a face can reuse its keypoints.
+         */
+        FaceKeypointCache(const float minIou, const int refreshInterval);
+
+        /**
+         * Whether each face can reuse the cached keypoints (true) or must be evaluated (false). Empty rectangles are never reused.
+         */
+        std::vector<bool> lookUp(const std::vector<Rectangle<float>>& faceRectangles);
+
+        /**
+         * It fills the reused faces of faceKeypoints (i.e. the ones not evaluated by the face network) and caches the result.
+         * @param reusedFaces The output of lookUp() for the same faceRectangles.
+         * @param scaleInputToOutput Scale from the face rectangles (input resolution) to the face keypoints (output resolution).
+         */
+        void update(Array<float>& faceKeypoints, const std::vector<Rectangle<float>>& faceRectangles, const std::vector<bool>& reusedFaces,
+                    const float scaleInputToOutput);
+
+    private:
+        const float mMinIou;
+        const int mRefreshInterval;
+        std::vector<Rectangle<float>> mFaceRectangles;
+        std::vector<int> mAges;
+        Array<float> mFaceKeypoints;
+        // Previous face matched by each current face (or -1)
+        std::vector<int> mMatches;
+
+        DELETE_COPY(FaceKeypointCache);
+    };
+}
+
+#endif // OPENPOSE_FACE_FACE_KEYPOINT_CACHE_HPP
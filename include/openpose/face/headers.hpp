@@ -5,6 +5,7 @@
 #include "enumClasses.hpp"
 #include "faceDetector.hpp"
 #include "faceExtractor.hpp"
+#include "faceKeypointCache.hpp"
 #include "faceParameters.hpp"
 #include "faceRenderer.hpp"
 #include "renderFace.hpp"
@@ -2,7 +2,9 @@
 #define OPENPOSE_FACE_W_FACE_DETECTOR_HPP
 
 #include <memory> // std::shared_ptr
+#include <openpose/core/personSelector.hpp>
 #include <openpose/thread/worker.hpp>
+#include "faceKeypointCache.hpp"
 #include "faceRenderer.hpp"
 
 namespace op
@@ -11,7 +13,15 @@ namespace op
     class WFaceExtractor : public Worker<TDatums>
     {
     public:
-        explicit WFaceExtractor(const std::shared_ptr<FaceExtractor>& faceExtractor);
+        /**
+         * @param personSelector If not nullptr, only the people selected by it are evaluated, and the keypoints of the remaining ones are
+         * marked with KEYPOINT_NOT_EVALUATED_SCORE.
+         * @param faceKeypointCache If not nullptr, the faces that barely moved since the previous frame reuse their previous keypoints
+         * instead of being evaluated.
+         */
+        explicit WFaceExtractor(const std::shared_ptr<FaceExtractor>& faceExtractor,
+                                const std::shared_ptr<PersonSelector>& personSelector = nullptr,
+                                const std::shared_ptr<FaceKeypointCache>& faceKeypointCache = nullptr);
 
         void initializationOnThread();
 
@@ -19,6 +29,8 @@ namespace op
 
     private:
         std::shared_ptr<FaceExtractor> spFaceExtractor;
+        std::shared_ptr<PersonSelector> spPersonSelector;
+        std::shared_ptr<FaceKeypointCache> spFaceKeypointCache;
 
         DELETE_COPY(WFaceExtractor);
     };
@@ -36,8 +48,12 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WFaceExtractor<TDatums>::WFaceExtractor(const std::shared_ptr<FaceExtractor>& faceExtractor) :
-        spFaceExtractor{faceExtractor}
+    WFaceExtractor<TDatums>::WFaceExtractor(const std::shared_ptr<FaceExtractor>& faceExtractor,
+                                            const std::shared_ptr<PersonSelector>& personSelector,
+                                            const std::shared_ptr<FaceKeypointCache>& faceKeypointCache) :
+        spFaceExtractor{faceExtractor},
+        spPersonSelector{personSelector},
+        spFaceKeypointCache{faceKeypointCache}
     {
     }
 
@@ -61,8 +77,52 @@ namespace op
                 // Extract people face
                 for (auto& tDatum : *tDatums)
                 {
-                    spFaceExtractor->forwardPass(tDatum.faceRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput);
-                    tDatum.faceKeypoints = spFaceExtractor->getFaceKeypoints();
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                    {
+                        if (spPersonSelector == nullptr && spFaceKeypointCache == nullptr)
+                        {
+                            spFaceExtractor->forwardPass(tDatum.faceRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                         tDatum.inputPyramid, tDatum.inputPyramidScales);
+                            tDatum.faceKeypoints = spFaceExtractor->getFaceKeypoints();
+                        }
+                        else
+                        {
+                            // Empty rectangles are not evaluated by FaceExtractor
+                            auto faceRectangles = tDatum.faceRectangles;
+                            std::vector<bool> selectedPeople;
+                            if (spPersonSelector != nullptr)
+                            {
+                                selectedPeople = spPersonSelector->select(tDatum.poseKeypoints);
+                                for (auto person = 0u ; person < faceRectangles.size() && person < selectedPeople.size() ; person++)
+                                    if (!selectedPeople[person])
+                                        faceRectangles[person] = Rectangle<float>{};
+                            }
+                            if (spFaceKeypointCache != nullptr)
+                            {
+                                const auto reusedFaces = spFaceKeypointCache->lookUp(faceRectangles);
+                                auto faceRectanglesToEvaluate = faceRectangles;
+                                for (auto person = 0u ; person < faceRectanglesToEvaluate.size() ; person++)
+                                    if (reusedFaces[person])
+                                        faceRectanglesToEvaluate[person] = Rectangle<float>{};
+                                spFaceExtractor->forwardPass(faceRectanglesToEvaluate, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                             tDatum.inputPyramid, tDatum.inputPyramidScales);
+                                tDatum.faceKeypoints = spFaceExtractor->getFaceKeypoints();
+                                spFaceKeypointCache->update(tDatum.faceKeypoints, faceRectangles, reusedFaces,
+                                                            tDatum.scaleInputToOutput);
+                            }
+                            else
+                            {
+                                spFaceExtractor->forwardPass(faceRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                             tDatum.inputPyramid, tDatum.inputPyramidScales);
+                                tDatum.faceKeypoints = spFaceExtractor->getFaceKeypoints();
+                            }
+                            if (spPersonSelector != nullptr)
+                                spPersonSelector->markNotEvaluated(tDatum.faceKeypoints, selectedPeople);
+                        }
+                    }
+                    else
+                        tDatum.faceKeypoints = spFaceExtractor->getFaceKeypoints();
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -7,6 +7,7 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <opencv2/highgui/highgui.hpp> // CV_LOAD_IMAGE_ANYDEPTH, CV_IMWRITE_PNG_COMPRESSION
 #include <openpose/core/array.hpp>
+#include <openpose/core/point.hpp>
 #include "enumClasses.hpp"
 
 
@@ -31,6 +32,30 @@ namespace op
 	OPENPOSE_API void saveImage(const cv::Mat& cvMat, const std::string& fullFilePath, const std::vector<int>& openCvCompressionParams = {CV_IMWRITE_JPEG_QUALITY, 100, CV_IMWRITE_PNG_COMPRESSION, 9});
 
     OPENPOSE_API cv::Mat loadImage(const std::string& fullFilePath, const int openCvFlags = CV_LOAD_IMAGE_ANYDEPTH);
+
+    /**
+     * Similar to loadImage(fullFilePath, CV_LOAD_IMAGE_COLOR), but JPEG images are decoded with the libjpeg DCT scaling
+     * (cv::IMREAD_REDUCED_COLOR_2/4/8) at the smallest power-of-two reduction that still covers each one of the target resolutions, i.e.
+     * the image is not upsampled when resized to fit into them (keeping the aspect ratio). Both orientations of the image are considered,
+     * so it also holds if the image is later rotated 90 or 270 degrees. A non-positive target axis is not constrained (e.g. {-1, 368}
+     * for a net input with dynamic width). Other formats are fully decoded.
+     * @param scale Output scale ratio between the loaded image and the original one (1 if it was not reduced).
+     */
+    OPENPOSE_API cv::Mat loadImageReduced(double& scale, const std::string& fullFilePath,
+                                          const std::vector<Point<int>>& targetResolutions);
+
+    /**
+     * It reads the encoded image file (e.g. the JPEG bytes) without decoding it, so reading and decoding can be overlapped on different
+     * threads (e.g. ImageDirectoryReader read-ahead).
+     */
+    OPENPOSE_API std::vector<unsigned char> loadEncodedImage(const std::string& fullFilePath);
+
+    /**
+     * Decoding part of loadImageReduced, over an image already read with loadEncodedImage. An empty targetResolutions decodes it at full
+     * resolution.
+     */
+    OPENPOSE_API cv::Mat decodeImageReduced(double& scale, const std::vector<unsigned char>& encodedImage,
+                                            const std::vector<Point<int>>& targetResolutions);
 }
 
 #endif // OPENPOSE_FILESTREAM_FILE_STREAM_HPP
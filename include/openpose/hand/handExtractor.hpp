@@ -5,6 +5,7 @@
 #include <atomic>
 #include <memory> // std::shared_ptr
 #include <thread>
+#include <vector>
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <opencv2/core/cuda.hpp> // cv::Mat
 #include <openpose/core/array.hpp>
@@ -26,11 +27,20 @@ namespace op
 
         void initializationOnThread();
 
+        /**
+         * All the left hands and the (horizontally mirrored) right hands of the frame are packed into a single batch, so the whole frame
+         * only requires 1 Caffe forward pass, independently of the number of people.
+         */
         void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::Mat& cvInputData,
                          const float scaleInputToOutput);
 
-		void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::cuda::GpuMat& cvInputData,
-			const float scaleInputToOutput);
+        /**
+         * @param inputPyramid Optional (e.g. Datum::inputPyramid), the hands that are downscaled are cropped from its smallest level with
+         * enough resolution (antialiased and smaller reads) rather than from cvInputData.
+         */
+        void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::cuda::GpuMat& cvInputData,
+                         const float scaleInputToOutput, const std::vector<cv::cuda::GpuMat>& inputPyramid = {},
+                         const std::vector<double>& inputPyramidScales = {});
 
         std::array<Array<float>, 2> getHandKeypoints() const;
 
@@ -48,7 +58,11 @@ namespace op
         std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
         std::shared_ptr<NmsCaffe<float>> spNmsCaffe;
         Array<float> mHandImageCrop;
+        cv::cuda::GpuMat mHandGpuImage;
         std::array<Array<float>, 2> mHandKeypoints;
+        // Batch crops: {person, hand (0 = left, 1 = right)} and their affine transformations (net input -> image)
+        std::vector<std::array<int, 2>> mCropIndexes;
+        std::vector<cv::Mat> mCropAffineMatrices;
         // Init with thread
         boost::shared_ptr<caffe::Blob<float>> spCaffeNetOutputBlob;
         std::shared_ptr<caffe::Blob<float>> spHeatMapsBlob;
@@ -57,6 +71,12 @@ namespace op
 
         void checkThread() const;
 
+        int setCrops(const std::vector<std::array<Rectangle<float>, 2>>& handRectangles);
+
+        void reshapeBatch(const int numberCrops);
+
+        void forwardPassBatch(const int numberCrops, const float scaleInputToOutput);
+
         void detectHandKeypoints(Array<float>& handCurrent, const float scaleInputToOutput, const int person, const cv::Mat& affineMatrix,
                                  const unsigned int handPeaksOffset);
 
@@ -2,6 +2,7 @@
 #define OPENPOSE_HAND_W_HAND_EXTRACTOR_HPP
 
 #include <memory> // std::shared_ptr
+#include <openpose/core/personSelector.hpp>
 #include <openpose/thread/worker.hpp>
 #include "handRenderer.hpp"
 
@@ -11,7 +12,12 @@ namespace op
     class WHandExtractor : public Worker<TDatums>
     {
     public:
-        explicit WHandExtractor(const std::shared_ptr<HandExtractor>& handExtractor);
+        /**
+         * @param personSelector If not nullptr, only the people selected by it are evaluated, and the keypoints of the remaining ones are
+         * marked with KEYPOINT_NOT_EVALUATED_SCORE.
+         */
+        explicit WHandExtractor(const std::shared_ptr<HandExtractor>& handExtractor,
+                                const std::shared_ptr<PersonSelector>& personSelector = nullptr);
 
         void initializationOnThread();
 
@@ -19,6 +25,7 @@ namespace op
 
     private:
         std::shared_ptr<HandExtractor> spHandExtractor;
+        std::shared_ptr<PersonSelector> spPersonSelector;
 
         DELETE_COPY(WHandExtractor);
     };
@@ -36,8 +43,10 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WHandExtractor<TDatums>::WHandExtractor(const std::shared_ptr<HandExtractor>& handExtractor) :
-        spHandExtractor{handExtractor}
+    WHandExtractor<TDatums>::WHandExtractor(const std::shared_ptr<HandExtractor>& handExtractor,
+                                            const std::shared_ptr<PersonSelector>& personSelector) :
+        spHandExtractor{handExtractor},
+        spPersonSelector{personSelector}
     {
     }
 
@@ -61,8 +70,32 @@ namespace op
                 // Extract people hands
                 for (auto& tDatum : *tDatums)
                 {
-                    spHandExtractor->forwardPass(tDatum.handRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput);
-                    tDatum.handKeypoints = spHandExtractor->getHandKeypoints();
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                    {
+                        if (spPersonSelector == nullptr)
+                        {
+                            spHandExtractor->forwardPass(tDatum.handRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                         tDatum.inputPyramid, tDatum.inputPyramidScales);
+                            tDatum.handKeypoints = spHandExtractor->getHandKeypoints();
+                        }
+                        else
+                        {
+                            // Empty rectangles are not evaluated by HandExtractor
+                            const auto selectedPeople = spPersonSelector->select(tDatum.poseKeypoints);
+                            auto handRectangles = tDatum.handRectangles;
+                            for (auto person = 0u ; person < handRectangles.size() && person < selectedPeople.size() ; person++)
+                                if (!selectedPeople[person])
+                                    handRectangles[person] = std::array<Rectangle<float>, 2>{};
+                            spHandExtractor->forwardPass(handRectangles, tDatum.cvInputData, tDatum.scaleInputToOutput,
+                                                         tDatum.inputPyramid, tDatum.inputPyramidScales);
+                            tDatum.handKeypoints = spHandExtractor->getHandKeypoints();
+                            for (auto& handKeypoints : tDatum.handKeypoints)
+                                spPersonSelector->markNotEvaluated(handKeypoints, selectedPeople);
+                        }
+                    }
+                    else
+                        tDatum.handKeypoints = spHandExtractor->getHandKeypoints();
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
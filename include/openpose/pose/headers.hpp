@@ -7,10 +7,18 @@
 #include "enumClasses.hpp"
 #include "poseExtractor.hpp"
 #include "poseExtractorCaffe.hpp"
+#include "poseExtractorCascade.hpp"
+#include "poseExtractorRoi.hpp"
+#include "poseExtractorTiled.hpp"
 #include "poseRenderer.hpp"
 #include "poseParameters.hpp"
+#include "poseTracker.hpp"
 #include "renderPose.hpp"
 #include "wPoseExtractor.hpp"
+#include "wPoseExtractorCascade.hpp"
+#include "wPoseExtractorRoi.hpp"
+#include "wPoseExtractorTiled.hpp"
+#include "wPoseExtractorTracking.hpp"
 #include "wPoseRenderer.hpp"
 
 #endif // OPENPOSE_POSE_HEADERS_HPP
@@ -31,6 +31,17 @@ namespace op
 		
     	virtual void forwardPass(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize, const std::vector<float>& scaleRatios = { 1.f }) = 0;
 
+        /**
+         * Same than forwardPass(), but inputNetData stacks the scales of several overlapping tiles of the same frame (e.g.
+         * PoseExtractorTiled), which run as a single network batch. The heat maps and PAFs of the tiles are merged into the ones of the
+         * whole frame (at the net input resolution of the tiles) before the peaks are extracted and the body parts connected. It must
+         * be called from the thread that runs forwardPass(). By default, it is not supported.
+         * @param tiles Rectangle of each tile in inputDataSize coordinates, all of them with the same size and in the inputNetData order.
+         * @param scaleRatios Scale ratios of the tiles (the same for all of them, as they have the same size).
+         */
+        virtual void forwardPassTiles(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize,
+                                      const std::vector<cv::Rect>& tiles, const std::vector<float>& scaleRatios = {1.f});
+
         virtual const float* getHeatMapCpuConstPtr() const = 0;
 
         virtual const float* getHeatMapGpuConstPtr() const = 0;
@@ -43,25 +54,51 @@ namespace op
 
         float getScaleNetToOutput() const;
 
+        /**
+         * Resolution of the heat maps, i.e. getHeatMapCpuConstPtr() and getHeatMapGpuConstPtr().
+         */
+        Point<int> getNetOutputSize() const;
+
         double get(const PoseProperty property) const;
 
         void set(const PoseProperty property, const double value);
 
         void increase(const PoseProperty property, const double value);
 
+        /**
+         * Static region of interest. It must match the one of the CvMatToOpInput that fills inputNetData (i.e. inputNetData only contains
+         * the bounding box of the mask). Peaks outside the mask are ignored and the keypoints are returned in full frame coordinates.
+         * It must be called before initializationOnThread().
+         * @param roiMask 1-channel 8-bit image with the input frame resolution, non-zero = useful area. Empty to disable it.
+         */
+        void setRoiMask(const cv::Mat& roiMask);
+
+        /**
+         * It reshapes the network (and the post-processing buffers) to a new net input resolution (e.g. the one selected by
+         * NetResolutionController). It does nothing if the resolution does not change. It must be called from the thread that runs
+         * forwardPass(). By default, it is not supported.
+         */
+        virtual void setNetInputSize(const Point<int>& netInputSize);
+
     protected:
         const PoseModel mPoseModel;
-        const Point<int> mNetOutputSize;
+        Point<int> mNetOutputSize;
         const Point<int> mOutputSize;
         Array<float> mPoseKeypoints;
         float mScaleNetToOutput;
+        cv::Mat mRoiMask;
+        cv::Rect mRoi;
+        const std::vector<HeatMapType> mHeatMapTypes;
 
         void checkThread() const;
 
+        void removePeaksOutsideRoiMask(float* peaksPtr, const double scaleRoiToNet) const;
+
+        void scaleRoiKeypointsToFrame(const Point<int>& inputDataSize, const double scaleRoiToNet);
+
         virtual void netInitializationOnThread() = 0;
 
     private:
-        const std::vector<HeatMapType> mHeatMapTypes;
         const ScaleMode mHeatMapScaleMode;
         std::array<std::atomic<double>, (int)PoseProperty::Size> mProperties;
         std::thread::id mThreadId;
@@ -19,9 +19,16 @@ namespace op
     class OPENPOSE_API  PoseExtractorCaffe : public PoseExtractor
     {
     public:
+        /**
+         * @param sparseHeatMaps If true (and no heatMapTypes are returned), the body part heat maps are only resized around the areas
+         * that can contain peaks (see resizeAndMergeSparseGpu), and set to 0 elsewhere. Same keypoints, only applied with 1 scale and
+         * without tiles. Only the resize is sparse: NMS still scans every pixel of every channel.
+         * @param parallelScales If true and scaleNumber > 1, the network runs each scale concurrently on the CPU (see NetCaffe).
+         */
         PoseExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize, const Point<int>& outputSize, const int scaleNumber,
                            const PoseModel poseModel, const std::string& modelFolder, const int gpuId, const std::vector<HeatMapType>& heatMapTypes = {},
-                           const ScaleMode heatMapScale = ScaleMode::ZeroToOne);
+                           const ScaleMode heatMapScale = ScaleMode::ZeroToOne, const bool sparseHeatMaps = false,
+                           const bool parallelScales = false);
 
         virtual ~PoseExtractorCaffe();
 
@@ -32,16 +39,23 @@ namespace op
     	
 		void forwardPass(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize, const std::vector<float>& scaleRatios = { 1.f });
 
+        void forwardPassTiles(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize, const std::vector<cv::Rect>& tiles,
+                              const std::vector<float>& scaleRatios = {1.f});
+
         const float* getHeatMapCpuConstPtr() const;
 
         const float* getHeatMapGpuConstPtr() const;
 
         const float* getPoseGpuConstPtr() const;
 
+        void setNetInputSize(const Point<int>& netInputSize);
+
     private:
         const float mResizeScale;
+        const bool mSparseHeatMaps;
 
-		void forwardPassInternal(const Point<int>& inputDataSize, const std::vector<float>& scaleRatios);
+		void forwardPassInternal(const Point<int>& inputDataSize, const std::vector<float>& scaleRatios,
+		                         const std::vector<cv::Rect>& tiles = {});
 
         std::shared_ptr<Net> spNet;
         std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
@@ -53,8 +67,8 @@ namespace op
         std::shared_ptr<caffe::Blob<float>> spPeaksBlob;
         std::shared_ptr<caffe::Blob<float>> spPoseBlob;
 
-		const std::array<int, 4> mNetInputSize4D;
-		const unsigned long mNetInputMemory;
+		std::array<int, 4> mNetInputSize4D;
+		unsigned long mNetInputMemory;
 
         DELETE_COPY(PoseExtractorCaffe);
     };
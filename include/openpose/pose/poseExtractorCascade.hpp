@@ -0,0 +1,59 @@
+#ifndef OPENPOSE_POSE_POSE_EXTRACTOR_CASCADE_HPP
+#define OPENPOSE_POSE_POSE_EXTRACTOR_CASCADE_HPP
+
+#include <memory> // std::shared_ptr
+#include <vector>
+#include <opencv2/core/core.hpp> // cv::Rect
+#include <opencv2/core/cuda.hpp> // cv::cuda::GpuMat
+#include <openpose/core/array.hpp>
+#include <openpose/core/cvMatToOpInput.hpp>
+#include <openpose/core/gpuArray.hpp>
+#include <openpose/core/point.hpp>
+#include <openpose/core/rectangle.hpp>
+#include <openpose/utilities/macros.hpp>
+#include "poseExtractor.hpp"
+
+namespace op
+{
+    /**
+     * PoseExtractorCascade is a two-stage alternative to a high net input resolution. A first whole-frame pass (usually at a low net input
+     * resolution) finds the candidate people. Then, the small ones (height below `maxHeightRatio` of the frame height) are processed again on
+     * a padded crop around them, which is upscaled to the net input size, and their keypoints are replaced by the ones of the crop.
+     * Most of the accuracy on distant people is kept, while the cost only grows with the number of small people (up to `maxCrops`).
+     */
+    class OPENPOSE_API PoseExtractorCascade
+    {
+    public:
+        PoseExtractorCascade(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize, const PoseModel poseModel,
+                             const int scaleNumber, const float scaleGap, const float maxHeightRatio, const int maxCrops);
+
+        void initializationOnThread();
+
+        void forwardPass(const GpuArray<float>& inputNetData, const cv::cuda::GpuMat& cvInputData, const std::vector<float>& scaleRatios,
+                         const float scaleInputToOutput);
+
+        Array<float> getHeatMaps() const;
+
+        Array<float> getPoseKeypoints() const;
+
+        float getScaleNetToOutput() const;
+
+    private:
+        const std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const Point<int> mNetInputSize;
+        const unsigned int mNumberBodyParts;
+        const float mMaxHeightRatio;
+        const int mMaxCrops;
+        const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        GpuArray<float> mCropNetData;
+        Array<float> mHeatMaps;
+        Array<float> mPoseKeypoints;
+        float mScaleNetToOutput;
+
+        cv::Rect getCrop(const Rectangle<float>& personRectangle, const Point<int>& frameSize) const;
+
+        DELETE_COPY(PoseExtractorCascade);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_EXTRACTOR_CASCADE_HPP
@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_POSE_POSE_EXTRACTOR_ROI_HPP
+#define OPENPOSE_POSE_POSE_EXTRACTOR_ROI_HPP
+
+#include <memory> // std::shared_ptr
+#include <vector>
+#include <opencv2/core/cuda.hpp> // cv::cuda::GpuMat
+#include <openpose/core/array.hpp>
+#include <openpose/core/cvMatToOpInput.hpp>
+#include <openpose/core/gpuArray.hpp>
+#include <openpose/core/point.hpp>
+#include <openpose/core/rectangle.hpp>
+#include <openpose/utilities/macros.hpp>
+#include "poseExtractor.hpp"
+
+namespace op
+{
+    /**
+     * PoseExtractorRoi runs the body network only on the region of interest (ROI) around the people found in the previous frame, i.e. the
+     * padded union of their getKeypointsRectangle(). Since the net input size is kept, the people are processed at equal or higher effective
+     * resolution than with the full frame, while most of the background is skipped.
+     * The full frame is still processed every `fullFrameInterval` frames (and whenever no one was found) in order to detect new people.
+     * Note: Not thread-safe, it requires consecutive frames. On cropped frames, getHeatMaps() is empty.
+     */
+    class OPENPOSE_API PoseExtractorRoi
+    {
+    public:
+        PoseExtractorRoi(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize, const int scaleNumber,
+                         const float scaleGap, const int fullFrameInterval, const float roiPadding);
+
+        void initializationOnThread();
+
+        /**
+         * @param inputNetData Full frame net input (i.e. Datum::inputNetData), only used on full frame passes.
+         */
+        void forwardPass(const GpuArray<float>& inputNetData, const cv::cuda::GpuMat& cvInputData, const std::vector<float>& scaleRatios,
+                         const float scaleInputToOutput);
+
+        Array<float> getHeatMaps() const;
+
+        Array<float> getPoseKeypoints() const;
+
+        float getScaleNetToOutput() const;
+
+    private:
+        const std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const Point<int> mNetInputSize;
+        const int mFullFrameInterval;
+        const float mRoiPadding;
+        const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        GpuArray<float> mRoiNetData;
+        unsigned long long mFrameCounter;
+        Rectangle<float> mPreviousRoi;
+        bool mLastFrameCropped;
+        Array<float> mPoseKeypoints;
+        float mScaleNetToOutput;
+
+        cv::Rect getPaddedRoi(const Point<int>& frameSize) const;
+
+        DELETE_COPY(PoseExtractorRoi);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_EXTRACTOR_ROI_HPP
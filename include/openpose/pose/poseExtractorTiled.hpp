@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_POSE_POSE_EXTRACTOR_TILED_HPP
+#define OPENPOSE_POSE_POSE_EXTRACTOR_TILED_HPP
+
+#include <memory> // std::shared_ptr
+#include <vector>
+#include <opencv2/core/core.hpp> // cv::Rect
+#include <opencv2/core/cuda.hpp> // cv::cuda::GpuMat
+#include <openpose/core/array.hpp>
+#include <openpose/core/cvMatToOpInput.hpp>
+#include <openpose/core/gpuArray.hpp>
+#include <openpose/core/point.hpp>
+#include <openpose/utilities/macros.hpp>
+#include "poseExtractor.hpp"
+
+namespace op
+{
+    /**
+     * PoseExtractorTiled processes very high resolution frames (e.g. 4K or 8K) without shrinking the whole frame to the net input size (which
+     * makes distant people disappear) and without increasing the net input size. The frame is split into overlapping tiles of the net
+     * input size (at `tileScale` of the original resolution), which run as a single network batch (PoseExtractor::forwardPassTiles). The
+     * heat maps and PAFs of the tiles are merged into the ones of the whole frame before the peaks are extracted and the body parts
+     * connected, so the people cut by a seam are connected across it and found only once.
+     * The network memory grows with the number of tiles (batch size), and the heat map memory with the tiled frame resolution (i.e. the
+     * frame resolution times `tileScale`). getHeatMaps() is empty.
+     */
+    class OPENPOSE_API PoseExtractorTiled
+    {
+    public:
+        /**
+         * @param tileScale Resolution at which the frame is processed, relative to the original one (1 = original resolution).
+         * @param tileOverlap Overlap between consecutive tiles, relative to the tile size. The merged heat maps fade each tile towards
+         * its border (where the network misses context), so the overlap should leave enough context around the seams.
+         */
+        PoseExtractorTiled(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize, const int scaleNumber,
+                           const float scaleGap, const float tileScale, const float tileOverlap);
+
+        void initializationOnThread();
+
+        void forwardPass(const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput);
+
+        Array<float> getPoseKeypoints() const;
+
+        float getScaleNetToOutput() const;
+
+    private:
+        const std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const Point<int> mNetInputSize;
+        const float mTileScale;
+        const float mTileOverlap;
+        const std::shared_ptr<CvMatToOpInput> spCvMatToOpInput;
+        GpuArray<float> mTileNetData;
+        // All the tiles stacked into a single network batch
+        GpuArray<float> mTilesNetData;
+        Array<float> mPoseKeypoints;
+        float mScaleNetToOutput;
+
+        std::vector<cv::Rect> getTiles(const Point<int>& frameSize) const;
+
+        DELETE_COPY(PoseExtractorTiled);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_EXTRACTOR_TILED_HPP
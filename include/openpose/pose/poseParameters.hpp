@@ -207,6 +207,10 @@ namespace op
         0.4f,       0.4f,       0.4f,       0.4f
     };
 
+    // Keyframe tracking parameters
+    const auto POSE_DEFAULT_TRACKING_MIN_RATIO = 0.5f;
+    const auto POSE_DEFAULT_TRACKING_MAX_ERROR = 30.f;
+
     // Rendering parameters
     const auto POSE_DEFAULT_ALPHA_KEYPOINT = 0.6f;
     const auto POSE_DEFAULT_ALPHA_HEAT_MAP = 0.7f;
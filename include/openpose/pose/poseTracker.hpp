@@ -0,0 +1,57 @@
+#ifndef OPENPOSE_POSE_POSE_TRACKER_HPP
+#define OPENPOSE_POSE_POSE_TRACKER_HPP
+
+#include <vector>
+#include <opencv2/core/core.hpp> // cv::Mat, cv::Point2f
+#include <openpose/core/array.hpp>
+#include <openpose/utilities/macros.hpp>
+#include "poseParameters.hpp"
+
+namespace op
+{
+    /**
+     * PoseTracker propagates the last keyframe poseKeypoints to the following frames by means of sparse (pyramidal Lucas-Kanade)
+     * optical flow on the keypoint locations, so the body network only has to be run every `keyframeInterval` frames.
+     * Note: This class is not thread-safe, it requires consecutive frames. Each WPoseExtractorTracking owns its own PoseTracker.
+     */
+    class OPENPOSE_API PoseTracker
+    {
+    public:
+        /**
+         * @param keyframeInterval Number of frames between consecutive keyframes (1 = the net runs on every frame).
+         * @param minTrackedRatio Minimum ratio of successfully tracked keypoints. Below it, tracking is considered lost and a new keyframe is
+         * forced.
+         * @param maxTrackingError Maximum Lucas-Kanade error of a keypoint to consider it successfully tracked.
+         */
+        explicit PoseTracker(const int keyframeInterval, const float minTrackedRatio = POSE_DEFAULT_TRACKING_MIN_RATIO,
+                             const float maxTrackingError = POSE_DEFAULT_TRACKING_MAX_ERROR);
+
+        bool isKeyframeRequired() const;
+
+        void setKeyframe(const cv::Mat& cvInputData, const Array<float>& poseKeypoints);
+
+        /**
+         * It propagates the previous keypoints into cvInputData.
+         * @return Whether tracking succeeded. If false, poseKeypoints is not modified and a keyframe is required.
+         */
+        bool track(Array<float>& poseKeypoints, const cv::Mat& cvInputData, const float scaleInputToOutput);
+
+    private:
+        const int mKeyframeInterval;
+        const float mMinTrackedRatio;
+        const float mMaxTrackingError;
+        int mFramesSinceKeyframe;
+        bool mTrackingLost;
+        cv::Mat mPreviousGray;
+        Array<float> mPreviousKeypoints;
+        std::vector<cv::Point2f> mPreviousPoints;
+        std::vector<cv::Point2f> mCurrentPoints;
+        std::vector<int> mPointIndexes;
+
+        void setPrevious(const cv::Mat& cvInputData, const Array<float>& poseKeypoints);
+
+        DELETE_COPY(PoseTracker);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_TRACKER_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 
 #include <memory> // std::shared_ptr
+#include <openpose/core/netResolutionController.hpp>
 #include <openpose/thread/worker.hpp>
 #include "poseExtractor.hpp"
 
@@ -11,7 +12,15 @@ namespace op
     class WPoseExtractor : public Worker<TDatums>
     {
     public:
-        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr);
+        /**
+         * @param netResolutionController Optional, if not nullptr, the pose extractor is reshaped to the net input resolution of each
+         * frame (Datum::netInputSize) and the latency of each frame (from Datum::timestamp to its pose output) is reported to it.
+         * @param dynamicNetInputWidth Whether the net input width changes with the aspect ratio of each frame, i.e. whether the pose
+         * extractor must be reshaped to Datum::netInputSize even without netResolutionController.
+         */
+        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr,
+                                const bool dynamicNetInputWidth = false);
 
         void initializationOnThread();
 
@@ -19,6 +28,8 @@ namespace op
 
     private:
         std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        const bool mDynamicNetInputWidth;
 
         DELETE_COPY(WPoseExtractor);
     };
@@ -29,6 +40,7 @@ namespace op
 
 
 // Implementation
+#include <chrono>
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/utilities/macros.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
@@ -36,8 +48,12 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr) :
-        spPoseExtractor{poseExtractorSharedPtr}
+    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                            const std::shared_ptr<NetResolutionController>& netResolutionController,
+                                            const bool dynamicNetInputWidth) :
+        spPoseExtractor{poseExtractorSharedPtr},
+        spNetResolutionController{netResolutionController},
+        mDynamicNetInputWidth{dynamicNetInputWidth}
     {
     }
 
@@ -61,10 +77,24 @@ namespace op
                 // Extract people pose
                 for (auto& tDatum : *tDatums)
                 {
-                    spPoseExtractor->forwardPass(tDatum.inputNetData, Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows}, tDatum.scaleRatios);
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                    {
+                        // Net input resolution adapted to the latency budget and/or its width to the frame aspect ratio
+                        if (spNetResolutionController != nullptr || mDynamicNetInputWidth)
+                            spPoseExtractor->setNetInputSize(tDatum.netInputSize);
+                        spPoseExtractor->forwardPass(tDatum.inputNetData, Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows}, tDatum.scaleRatios);
+                    }
                     tDatum.poseHeatMaps = spPoseExtractor->getHeatMaps();
                     tDatum.poseKeypoints = spPoseExtractor->getPoseKeypoints();
                     tDatum.scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                    // End-to-end latency (from the producer timestamp to the pose output, including queueing and preprocessing)
+                    if (spNetResolutionController != nullptr && !tDatum.inferenceSkipped)
+                    {
+                        const auto end = std::chrono::high_resolution_clock::now();
+                        spNetResolutionController->report(std::chrono::duration<double, std::milli>(end - tDatum.timestamp).count(),
+                                                          tDatum.netInputSize);
+                    }
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -0,0 +1,94 @@
+#ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_CASCADE_HPP
+#define OPENPOSE_POSE_W_POSE_EXTRACTOR_CASCADE_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "poseExtractorCascade.hpp"
+
+namespace op
+{
+    /**
+     * Alternative to WPoseExtractor that refines the small people found in the whole frame with a second pass on upscaled crops.
+     * See PoseExtractorCascade for details.
+     */
+    template<typename TDatums>
+    class WPoseExtractorCascade : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseExtractorCascade(const std::shared_ptr<PoseExtractorCascade>& poseExtractorCascadeSharedPtr);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseExtractorCascade> spPoseExtractorCascade;
+
+        DELETE_COPY(WPoseExtractorCascade);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseExtractorCascade<TDatums>::WPoseExtractorCascade(const std::shared_ptr<PoseExtractorCascade>& poseExtractorCascadeSharedPtr) :
+        spPoseExtractorCascade{poseExtractorCascadeSharedPtr}
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorCascade<TDatums>::initializationOnThread()
+    {
+        spPoseExtractorCascade->initializationOnThread();
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorCascade<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Extract people pose
+                for (auto& tDatum : *tDatums)
+                {
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                        spPoseExtractorCascade->forwardPass(tDatum.inputNetData, tDatum.cvInputData, tDatum.scaleRatios,
+                                                            tDatum.scaleInputToOutput);
+                    tDatum.poseHeatMaps = spPoseExtractorCascade->getHeatMaps();
+                    tDatum.poseKeypoints = spPoseExtractorCascade->getPoseKeypoints();
+                    tDatum.scaleNetToOutput = spPoseExtractorCascade->getScaleNetToOutput();
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseExtractorCascade);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_EXTRACTOR_CASCADE_HPP
@@ -0,0 +1,94 @@
+#ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_ROI_HPP
+#define OPENPOSE_POSE_W_POSE_EXTRACTOR_ROI_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "poseExtractorRoi.hpp"
+
+namespace op
+{
+    /**
+     * Alternative to WPoseExtractor that only runs the body network on the region of the frame around the previously detected people.
+     * See PoseExtractorRoi for details.
+     */
+    template<typename TDatums>
+    class WPoseExtractorRoi : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseExtractorRoi(const std::shared_ptr<PoseExtractorRoi>& poseExtractorRoiSharedPtr);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseExtractorRoi> spPoseExtractorRoi;
+
+        DELETE_COPY(WPoseExtractorRoi);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseExtractorRoi<TDatums>::WPoseExtractorRoi(const std::shared_ptr<PoseExtractorRoi>& poseExtractorRoiSharedPtr) :
+        spPoseExtractorRoi{poseExtractorRoiSharedPtr}
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorRoi<TDatums>::initializationOnThread()
+    {
+        spPoseExtractorRoi->initializationOnThread();
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorRoi<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Extract people pose
+                for (auto& tDatum : *tDatums)
+                {
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                        spPoseExtractorRoi->forwardPass(tDatum.inputNetData, tDatum.cvInputData, tDatum.scaleRatios,
+                                                        tDatum.scaleInputToOutput);
+                    tDatum.poseHeatMaps = spPoseExtractorRoi->getHeatMaps();
+                    tDatum.poseKeypoints = spPoseExtractorRoi->getPoseKeypoints();
+                    tDatum.scaleNetToOutput = spPoseExtractorRoi->getScaleNetToOutput();
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseExtractorRoi);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_EXTRACTOR_ROI_HPP
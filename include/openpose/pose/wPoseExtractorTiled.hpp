@@ -0,0 +1,95 @@
+#ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_TILED_HPP
+#define OPENPOSE_POSE_W_POSE_EXTRACTOR_TILED_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "poseExtractorTiled.hpp"
+
+namespace op
+{
+    /**
+     * Alternative to WPoseExtractor for very high resolution frames, it runs the body network on overlapping tiles of the frame (as a
+     * single batch).
+     * See PoseExtractorTiled for details.
+     */
+    template<typename TDatums>
+    class WPoseExtractorTiled : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseExtractorTiled(const std::shared_ptr<PoseExtractorTiled>& poseExtractorTiledSharedPtr);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseExtractorTiled> spPoseExtractorTiled;
+
+        DELETE_COPY(WPoseExtractorTiled);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseExtractorTiled<TDatums>::WPoseExtractorTiled(const std::shared_ptr<PoseExtractorTiled>& poseExtractorTiledSharedPtr) :
+        spPoseExtractorTiled{poseExtractorTiledSharedPtr}
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorTiled<TDatums>::initializationOnThread()
+    {
+        spPoseExtractorTiled->initializationOnThread();
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorTiled<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Extract people pose
+                for (auto& tDatum : *tDatums)
+                {
+                    // If skipped (e.g. static frame), the results of the last processed frame are reused
+                    if (!tDatum.inferenceSkipped)
+                        spPoseExtractorTiled->forwardPass(tDatum.cvInputData, tDatum.scaleInputToOutput);
+                    // The merged heat maps have the tiled frame resolution, not the net output one of PoseExtractor::getHeatMaps()
+                    tDatum.poseHeatMaps.reset();
+                    tDatum.poseKeypoints = spPoseExtractorTiled->getPoseKeypoints();
+                    tDatum.scaleNetToOutput = spPoseExtractorTiled->getScaleNetToOutput();
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseExtractorTiled);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_EXTRACTOR_TILED_HPP
@@ -0,0 +1,110 @@
+#ifndef OPENPOSE_POSE_W_POSE_EXTRACTOR_TRACKING_HPP
+#define OPENPOSE_POSE_W_POSE_EXTRACTOR_TRACKING_HPP
+
+#include <memory> // std::shared_ptr
+#include <openpose/thread/worker.hpp>
+#include "poseExtractor.hpp"
+#include "poseTracker.hpp"
+
+namespace op
+{
+    /**
+     * Alternative to WPoseExtractor for video/webcam streams. The body network only runs on keyframes (every `keyframeInterval` frames or
+     * whenever the tracking is lost), and the poseKeypoints are propagated with optical flow on the frames in between.
+     * On propagated frames, Datum::poseHeatMaps is empty.
+     */
+    template<typename TDatums>
+    class WPoseExtractorTracking : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseExtractorTracking(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                        const std::shared_ptr<PoseTracker>& poseTrackerSharedPtr);
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseExtractor> spPoseExtractor;
+        std::shared_ptr<PoseTracker> spPoseTracker;
+
+        DELETE_COPY(WPoseExtractorTracking);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/profiler.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseExtractorTracking<TDatums>::WPoseExtractorTracking(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                                            const std::shared_ptr<PoseTracker>& poseTrackerSharedPtr) :
+        spPoseExtractor{poseExtractorSharedPtr},
+        spPoseTracker{poseTrackerSharedPtr}
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorTracking<TDatums>::initializationOnThread()
+    {
+        spPoseExtractor->initializationOnThread();
+    }
+
+    template<typename TDatums>
+    void WPoseExtractorTracking<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Extract (keyframe) or propagate (rest) people pose
+                for (auto& tDatum : *tDatums)
+                {
+                    // Propagated frame
+                    if (!spPoseTracker->isKeyframeRequired()
+                        && spPoseTracker->track(tDatum.poseKeypoints, tDatum.cvOutputData, tDatum.scaleInputToOutput))
+                    {
+                        tDatum.poseHeatMaps.reset();
+                        tDatum.scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                    }
+                    // Keyframe (or tracking lost)
+                    else
+                    {
+                        spPoseExtractor->forwardPass(tDatum.inputNetData, Point<int>{tDatum.cvInputData.cols, tDatum.cvInputData.rows},
+                                                     tDatum.scaleRatios);
+                        tDatum.poseHeatMaps = spPoseExtractor->getHeatMaps();
+                        tDatum.poseKeypoints = spPoseExtractor->getPoseKeypoints();
+                        tDatum.scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                        spPoseTracker->setKeyframe(tDatum.cvOutputData, tDatum.poseKeypoints);
+                    }
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, Profiler::DEFAULT_X);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseExtractorTracking);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_EXTRACTOR_TRACKING_HPP
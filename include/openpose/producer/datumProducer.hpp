@@ -2,6 +2,7 @@
 #define OPENPOSE_PRODUCER_DATUM_PRODUCER_HPP
 
 #include <atomic>
+#include <chrono>
 #include <limits> // std::numeric_limits
 #include <memory> // std::shared_ptr
 #include <tuple>
@@ -15,9 +16,14 @@ namespace op
     class DatumProducer
     {
     public:
+        /**
+         * @param flipAndRotateFrames Whether the producer applies ProducerProperty::Flip and Rotation. If false, Datum::cvInputData
+         * and cvOutputData are not flipped nor rotated yet (e.g. CvMatToOpOutput fuses them into the GPU resize).
+         */
         explicit DatumProducer(const std::shared_ptr<Producer>& producerSharedPtr, const unsigned long long frameFirst = 0,
                                const unsigned long long frameLast = std::numeric_limits<unsigned long long>::max(),
-                               const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr);
+                               const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr = nullptr,
+                               const bool flipAndRotateFrames = true);
 
         std::pair<bool, std::shared_ptr<TDatumsNoPtr>> checkIfRunningAndGetDatum();
 
@@ -27,6 +33,7 @@ namespace op
         unsigned long long mGlobalCounter;
         unsigned int mNumberConsecutiveEmptyFrames;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        const bool mFlipAndRotateFrames;
 
 		cv::cuda::GpuMat currentGpuMat;
 
@@ -47,12 +54,14 @@ namespace op
 {
     template<typename TDatumsNoPtr>
     DatumProducer<TDatumsNoPtr>::DatumProducer(const std::shared_ptr<Producer>& producerSharedPtr, const unsigned long long frameFirst, const unsigned long long frameLast,
-                                               const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr) :
+                                               const std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>>& videoSeekSharedPtr,
+                                               const bool flipAndRotateFrames) :
         mNumberFramesToProcess{(frameLast != std::numeric_limits<unsigned long long>::max() ? frameLast - frameFirst : frameLast)},
         spProducer{producerSharedPtr},
         mGlobalCounter{0ll},
         mNumberConsecutiveEmptyFrames{0u},
-        spVideoSeek{videoSeekSharedPtr}
+        spVideoSeek{videoSeekSharedPtr},
+        mFlipAndRotateFrames{flipAndRotateFrames}
     {
         try
         {
@@ -93,8 +102,10 @@ namespace op
                     }
                 }
                 // Get cv::Mat
+                datum.timestamp = std::chrono::high_resolution_clock::now();
                 datum.name = spProducer->getFrameName();
-				datum.cvOutputData = spProducer->getFrame();
+				datum.cvOutputData = spProducer->getFrame(mFlipAndRotateFrames);
+                datum.scaleProducerToInput = (float)spProducer->getFrameScale();
 				currentGpuMat.upload(datum.cvOutputData);
 				datum.cvInputData = currentGpuMat;
                 
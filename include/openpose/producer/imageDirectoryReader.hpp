@@ -1,7 +1,11 @@
 #ifndef OPENPOSE_PRODUCER_IMAGE_DIRECTORY_READER_HPP
 #define OPENPOSE_PRODUCER_IMAGE_DIRECTORY_READER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <openpose/core/point.hpp>
 #include "producer.hpp"
@@ -20,11 +24,42 @@ namespace op
          * Constructor of ImageDirectoryReader. It sets the image directory path from which the images will be loaded and
          * generates a std::vector<std::string> with the list of images on that directory.
          * @param imageDirectoryPath const std::string parameter with the folder path containing the images.
+         * @param readAheadImages Number of following images read and decoded in background while the current one is processed (0 to
+         * read and decode them synchronously on getFrame). Frames are still returned in order.
+         * @param decodingThreads Number of threads decoding the read-ahead images in parallel. The files are read on an additional
+         * thread, overlapping the decoding.
          */
-        explicit ImageDirectoryReader(const std::string& imageDirectoryPath);
+        explicit ImageDirectoryReader(const std::string& imageDirectoryPath, const int readAheadImages = 0,
+                                      const int decodingThreads = 1);
+
+        ~ImageDirectoryReader();
 
         std::string getFrameName();
 
+        /**
+         * It enables the reduced JPEG decoding (see loadImageReduced): each image is decoded at the smallest power-of-two reduction that
+         * still covers the resolutions at which it is going to be sampled (e.g. net input and output resolutions). Any frame consumer
+         * must only downsample Datum::cvInputData (e.g. no face or hand crops). An empty vector disables it. It must be called before the
+         * first frame is retrieved.
+         * @param targetResolutions std::vector<Point<int>> with the resolutions at which the frames are going to be sampled.
+         */
+        void setReducedDecoding(const std::vector<Point<int>>& targetResolutions);
+
+        inline double getFrameScale()
+        {
+            return mFrameScale;
+        }
+
+        /**
+         * Number of frames for which getFrame had to wait for the read-ahead decoding (i.e. the decoding was the bottleneck). Always 0
+         * if readAheadImages == 0.
+         * @return unsigned long long with the number of stalled frames.
+         */
+        inline unsigned long long getReadAheadStalls() const
+        {
+            return mReadAheadStalls;
+        }
+
         inline bool isOpened() const
         {
             return (mFrameNameCounter >= 0);
@@ -54,9 +89,45 @@ namespace op
         const std::vector<std::string> mFilePaths;
         Point<int> mResolution;
         long long mFrameNameCounter;
+        std::vector<Point<int>> mTargetResolutions;
+        double mFrameScale;
+        // Read-ahead
+        enum class ReadAheadState : unsigned char
+        {
+            Free,
+            Reading,
+            Read,
+            Decoding,
+            Decoded,
+        };
+        struct ReadAheadImage
+        {
+            long long frameIndex;
+            ReadAheadState state;
+            std::vector<unsigned char> encodedImage;
+            cv::Mat frame;
+            double frameScale;
+        };
+        const int mDecodingThreads;
+        std::vector<ReadAheadImage> mReadAheadImages; // Ring buffer, frame i on mReadAheadImages[i % readAheadImages]
+        long long mNextFrameToRead;
+        unsigned long long mReadAheadGeneration; // Increased when flushed, so the in-flight reads/decodings are discarded
+        std::atomic<unsigned long long> mReadAheadStalls;
+        std::atomic<bool> mCloseThreads;
+        std::mutex mReadAheadMutex;
+        std::condition_variable mReadAheadConditionVariable;
+        std::vector<std::thread> mThreads;
 
         cv::Mat getRawFrame();
 
+        cv::Mat getReadAheadFrame();
+
+        void flushReadAhead();
+
+        void readingThread();
+
+        void decodingThread();
+
         DELETE_COPY(ImageDirectoryReader);
     };
 }
@@ -34,9 +34,11 @@ namespace op
 
         /**
          * Main function of Producer, it retrieves and returns a new frame from the frames producer.
+         * @param flipAndRotateFrame Whether to apply ProducerProperty::Flip and Rotation. If false, the frame is returned as retrieved
+         * and the caller applies them (e.g. fused into the GPU resize, CvMatToOpOutput).
          * @return cv::Mat with the new frame. 
          */
-        cv::Mat getFrame();
+        cv::Mat getFrame(const bool flipAndRotateFrame = true);
 
         /**
          * This function returns a unique frame name (e.g. the frame number for video, the
@@ -45,6 +47,16 @@ namespace op
          */
         virtual std::string getFrameName() = 0;
 
+        /**
+         * This function returns the scale ratio between the last frame retrieved by getFrame and the original source frame, lower than 1
+         * if the producer decoded it at a reduced resolution (e.g. ImageDirectoryReader::setReducedDecoding).
+         * @return double with the scale ratio.
+         */
+        virtual double getFrameScale()
+        {
+            return 1.;
+        }
+
         /**
          * This function sets whether the producer must keep the original fps frame rate or extract the frames as quick
          * as possible.
@@ -102,8 +114,10 @@ namespace op
          * might return corrupted frames within a video or webcam with a size different to the
          * standard resolution). If the frame is corrupted, it is set to an empty cv::Mat.
          * @param frame cv::Mat with the frame matrix to be checked and modified.
+         * @param flippedAndRotated Whether ProducerProperty::Flip and Rotation were already applied to the frame (i.e. whether its size
+         * is compared with the rotated resolution).
          */
-        void checkFrameIntegrity(cv::Mat& frame);
+        void checkFrameIntegrity(cv::Mat& frame, const bool flippedAndRotated = true);
 
         /**
          * It performs flipping and rotation over the desired cv::Mat.
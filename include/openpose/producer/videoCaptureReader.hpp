@@ -59,6 +59,13 @@ namespace op
     protected:
         virtual cv::Mat getRawFrame() = 0;
 
+        /**
+         * Same than getRawFrame, but it decodes the frame into the given cv::Mat, reusing its memory if it already has the frame size and
+         * type (e.g. a preallocated buffer). If no more frames can be retrieved, frame is left empty.
+         * @param frame cv::Mat where the frame is decoded.
+         */
+        void retrieveFrame(cv::Mat& frame);
+
     private:
         cv::VideoCapture mVideoCapture;
 
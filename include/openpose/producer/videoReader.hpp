@@ -1,6 +1,11 @@
 #ifndef OPENPOSE_PRODUCER_VIDEO_READER_HPP
 #define OPENPOSE_PRODUCER_VIDEO_READER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "videoCaptureReader.hpp"
 
 namespace op
@@ -16,26 +21,45 @@ namespace op
          * Constructor of VideoReader. It opens the video as a wrapper of cv::VideoCapture. It includes a flag to indicate
          * whether the video should be repeated once it is completely read.
          * @param videoPath const std::string parameter with the full video path location.
+         * @param prefetchFrames Number of frames decoded ahead on a background thread, into a ring of preallocated cv::Mat (0 to decode
+         * them synchronously on getFrame). Seeking (CV_CAP_PROP_POS_FRAMES) flushes them.
          */
-        explicit VideoReader(const std::string& videoPath);
+        explicit VideoReader(const std::string& videoPath, const int prefetchFrames = 0);
+
+        ~VideoReader();
 
         std::string getFrameName();
 
-        inline double get(const int capProperty)
-        {
-            return VideoCaptureReader::get(capProperty);
-        }
+        void release();
+
+        double get(const int capProperty);
 
-        inline void set(const int capProperty, const double value)
-        {
-            VideoCaptureReader::set(capProperty, value);
-        }
+        void set(const int capProperty, const double value);
 
     private:
         const std::string mPathName;
+        // Background decoding
+        std::vector<cv::Mat> mFrames; // Ring buffer
+        unsigned int mFirstFrame;
+        unsigned int mNumberFrames;
+        bool mEndOfVideo;
+        long long mFrameCounter; // Position of the next frame returned (the cv::VideoCapture one is ahead)
+        double mFrameCount;
+        double mFps;
+        double mWidth;
+        double mHeight;
+        std::atomic<bool> mCloseThread;
+        std::mutex mCaptureMutex;
+        std::mutex mFramesMutex;
+        std::condition_variable mFramesConditionVariable;
+        std::thread mThread;
 
         cv::Mat getRawFrame();
 
+        void closeThread();
+
+        void bufferingThread();
+
         DELETE_COPY(VideoReader);
     };
 }
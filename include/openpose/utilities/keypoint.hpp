@@ -23,7 +23,18 @@ namespace op
 
     float getKeypointsArea(const float* keypointPtr, const int numberKeypoints, const float threshold);
 
+    /**
+     * Union of the getKeypointsRectangle() of all the people, i.e. the smallest rectangle containing all of them.
+     * It returns an empty rectangle if there is no person.
+     */
+    Rectangle<float> getKeypointsRoi(const Array<float>& keypoints, const float threshold);
+
     int getBiggestPerson(const Array<float>& keypoints, const float threshold);
+
+    /**
+     * Intersection over union of 2 rectangles. It returns 0 if they do not overlap.
+     */
+    float getIou(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB);
 }
 
 #endif // OPENPOSE_UTILITIES_KEYPOINT_HPP
@@ -3,6 +3,7 @@
 
 #include <opencv2/core/core.hpp> // cv::Mat, cv::Point
 #include <opencv2/core/core.hpp> // cv::Mat
+#include <vector>
 #include <opencv2/core/core.hpp> // cv::Mat, cv::Point
 #include <opencv2/core/cuda.hpp>
 #include <opencv2/cudawarping.hpp>
@@ -28,16 +29,68 @@ namespace op
    
 	OPENPOSE_API double resizeGetScaleFactor(const Point<int>& initialSize, const Point<int>& targetSize);
 
+    /**
+     * Bounding box of the non-zero pixels of a 1-channel 8-bit mask. An empty rectangle if the mask is empty or all zeros.
+     */
+    OPENPOSE_API cv::Rect getMaskBoundingBox(const cv::Mat& mask);
+
     
    
 	OPENPOSE_API  cv::Mat resizeFixedAspectRatio(const cv::Mat& cvMat, const double scaleFactor, const Point<int>& targetSize, const int borderMode = cv::BORDER_CONSTANT,
                                    const cv::Scalar& borderValue = cv::Scalar{0,0,0});
 
+    /**
+     * Same than resizeFixedAspectRatio(cvMat, scaleFactor, targetSize), but it writes into resultingCvMat, reusing its memory if it
+     * already has the target size and type (e.g. a buffer kept between frames).
+     */
+    OPENPOSE_API void resizeFixedAspectRatio(const cv::Mat& cvMat, cv::Mat& resultingCvMat, const double scaleFactor, const Point<int>& targetSize,
+                                             const int borderMode = cv::BORDER_CONSTANT, const cv::Scalar& borderValue = cv::Scalar{0,0,0});
+
 	OPENPOSE_API void resizeFixedAspectRatioGpu(const cv::cuda::GpuMat& cvMat, cv::cuda::GpuMat& dst, const double scaleFactor, const Point<int>& targetSize, const int borderMode = cv::BORDER_CONSTANT,
 		const cv::Scalar& borderValue = cv::Scalar{ 0,0,0 });
 
+    /**
+     * Index of the smallest image pyramid level (e.g. Datum::inputPyramid) that still has at least 1 pixel per output pixel for a crop
+     * that samples `inputPixelsPerOutputPixel` pixels of the original image per output pixel, or -1 if no level is smaller than the
+     * original image. pyramidScales must be sorted from bigger to smaller.
+     */
+    OPENPOSE_API int getPyramidLevel(const std::vector<double>& pyramidScales, const double inputPixelsPerOutputPixel);
+
+    /**
+     * Source axes of a frame flipped and rotated as Producer::flipAndRotate does (ProducerProperty::Flip and Rotation): whether the x and
+     * y axes of the flipped and rotated frame run along the rows and columns of the original frame (transpose), and whether the columns
+     * (x) and rows (y) of the original frame are read backwards.
+     */
+    OPENPOSE_API void getFlipAndRotationAxes(bool& transpose, bool& mirrorColumns, bool& mirrorRows, const bool flip, const int rotation);
+
+    /**
+     * GPU version of Producer::flipAndRotate (exact copy, 1 pass). The memory of orientedCvMat is reused if it already has the right size
+     * and type.
+     */
+    OPENPOSE_API void flipAndRotateGpu(const cv::cuda::GpuMat& cvMat, cv::cuda::GpuMat& orientedCvMat, const bool flip, const int rotation);
+
 	OPENPOSE_API void gpuMatToFloatPtr(float* floatImage, const unsigned char* imgData, const int channels, const Point<int>& sourceSize, const size_t step, const bool normalize, const unsigned long offset);
 
+    /**
+     * 1-dimensional resampling table (e.g. for the columns or the rows) for resizeGpuMatToFloatPtr. For each target pixel, it contains
+     * `taps` (returned value) consecutive source indexes and weights. It uses area interpolation (antialiased, as cv::INTER_AREA) when
+     * downscaling, and bicubic interpolation (as cv::INTER_CUBIC) when upscaling.
+     */
+    OPENPOSE_API int getResizeTable(std::vector<int>& indexes, std::vector<float>& weights, const int sourceSize, const int targetSize);
+
+    /**
+     * Fused resize + normalization + HWC to CHW: it resamples the image (imgData) into the top-left levelSize region of the net input
+     * (floatImage + offset, netSize), and writes a constant black value in the remaining padding region. The resampling tables are the
+     * ones of getResizeTable (in GPU memory). If levelData is not nullptr, the resized uchar image is also written there (levelSize).
+     * xStride and yStride are the bytes between consecutive source indexes of the x and y tables, i.e. channels and step, or step and
+     * channels to read the image transposed (e.g. rotated 90 degrees, getFlipAndRotationAxes).
+     */
+    OPENPOSE_API void resizeGpuMatToFloatPtr(float* floatImage, unsigned char* levelData, const size_t levelStep, const unsigned char* imgData,
+                                             const int channels, const size_t xStride, const size_t yStride, const Point<int>& levelSize,
+                                             const Point<int>& netSize,
+                                             const int* xIndexes, const float* xWeights, const int xTaps, const int* yIndexes,
+                                             const float* yWeights, const int yTaps, const bool normalize, const unsigned long offset);
+
 	OPENPOSE_API void floatPtrToGpuMat(unsigned char* imgData, const float* floatImage, const int channels, const Point<int>& sourceSize, const size_t step);
 }
 
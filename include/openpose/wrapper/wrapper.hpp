@@ -207,8 +207,7 @@ namespace op
         std::vector<TWorker> mUserInputWs;
         TWorker wDatumProducer;
         TWorker spWIdGenerator;
-        TWorker spWCvMatToOpInput;
-        TWorker spWCvMatToOpOutput;
+        TWorker spWCvMatToOpInputOutput;
         std::vector<std::vector<TWorker>> spWPoses;
         std::vector<TWorker> mPostProcessingWs;
         std::vector<TWorker> mUserPostProcessingWs;
@@ -448,6 +447,59 @@ namespace op
                 error("Alpha value for blending must be in the range [0,1].", __LINE__, __FUNCTION__, __FILE__);
             if (wrapperStructPose.scaleGap <= 0.f && wrapperStructPose.scalesNumber > 1)
                 error("The scale gap must be greater than 0 (it has no effect if the number of scales is 1).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.keyframeInterval < 1)
+                error("The keyframe interval must be greater than 0 (1 disables pose tracking).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.roiFullFrameInterval < 0)
+                error("The ROI full frame interval cannot be negative (0 disables the person ROI mode).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.roiFullFrameInterval > 0 && wrapperStructPose.keyframeInterval > 1)
+                error("Pose tracking (keyframe interval > 1) and the person ROI mode cannot be enabled at the same time.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.motionGateThreshold < 0.f || wrapperStructPose.motionGateMaxSkips < 0)
+                error("The motion gate threshold and maximum number of skips cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.motionGateThreshold > 0.f && wrapperStructPose.keyframeInterval > 1)
+                error("Pose tracking (keyframe interval > 1) and the motion gate cannot be enabled at the same time.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.tileScale < 0.f || wrapperStructPose.tileOverlap < 0.f || wrapperStructPose.tileOverlap >= 1.f)
+                error("The tile scale cannot be negative (0 disables the tiled mode) and the tile overlap must be in the range [0, 1).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.tileScale > 0.f && (wrapperStructPose.keyframeInterval > 1 || wrapperStructPose.roiFullFrameInterval > 0
+                                                      || wrapperStructPose.parallelScales))
+                error("The tiled mode cannot be combined with pose tracking (keyframe interval > 1), the person ROI mode nor the parallel"
+                      " scales.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.cascadeMaxHeight < 0.f || wrapperStructPose.cascadeMaxHeight > 1.f || wrapperStructPose.cascadeMaxCrops < 1)
+                error("The cascade maximum height must be in the range [0, 1] (0 disables the cascade) and the maximum number of crops"
+                      " greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.cascadeMaxHeight > 0.f && (wrapperStructPose.keyframeInterval > 1
+                                                             || wrapperStructPose.roiFullFrameInterval > 0 || wrapperStructPose.tileScale > 0.f))
+                error("The cascade cannot be combined with pose tracking (keyframe interval > 1), the person ROI mode nor the tiled mode.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.latencyBudget < 0.f)
+                error("The latency budget cannot be negative (0 disables it).", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.latencyBudget > 0.f && (wrapperStructPose.keyframeInterval > 1 || wrapperStructPose.roiFullFrameInterval > 0
+                                                          || wrapperStructPose.tileScale > 0.f || wrapperStructPose.cascadeMaxHeight > 0.f))
+                error("The latency budget cannot be combined with pose tracking (keyframe interval > 1), the person ROI mode, the tiled mode"
+                      " nor the cascade.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.dynamicNetInputWidth && (wrapperStructPose.keyframeInterval > 1 || wrapperStructPose.roiFullFrameInterval > 0
+                                                           || wrapperStructPose.tileScale > 0.f || wrapperStructPose.cascadeMaxHeight > 0.f))
+                error("The dynamic net input width cannot be combined with pose tracking (keyframe interval > 1), the person ROI mode, the"
+                      " tiled mode nor the cascade.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.faceHandMaxPeople < 0)
+                error("The maximum number of people for face and hand cannot be negative (0 evaluates everybody).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.faceHandMaxPeople > 0 && wrapperStructPose.faceHandPersonPriority == PersonPriority::Callback
+                && !wrapperStructPose.faceHandPriorityFunction)
+                error("PersonPriority::Callback requires faceHandPriorityFunction.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructFace.cacheMinIou < 0.f || wrapperStructFace.cacheMinIou > 1.f || wrapperStructFace.cacheRefreshInterval < 1)
+                error("The face cache minimum IoU must be in the range [0, 1] (0 disables it) and the refresh interval greater than 0.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (!wrapperStructInput.roiMask.empty())
+            {
+                if (wrapperStructInput.roiMask.type() != CV_8UC1)
+                    error("The ROI mask must be a 1-channel 8-bit image.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.roiFullFrameInterval > 0 || wrapperStructPose.tileScale > 0.f || wrapperStructPose.cascadeMaxHeight > 0.f)
+                    error("The ROI mask cannot be combined with the person ROI mode, the tiled mode nor the cascade.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
             if (!renderOutput && (!wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()))
             {
                 const auto message = "In order to save the rendered frames (`write_images` or `write_video`), you must set `render_output` to true.";
@@ -515,6 +567,13 @@ namespace op
                 // Logging message
                 log("Auto-detecting GPUs... Detected " + std::to_string(gpuNumber) + " GPU(s), using them all.", Priority::High);
             }
+            if ((wrapperStructPose.keyframeInterval > 1 || wrapperStructPose.roiFullFrameInterval > 0) && gpuNumber > 1)
+                log("Pose tracking (keyframe interval > 1) or person ROI mode with several GPUs: each GPU only sees the frames it receives, so"
+                    " consider using `num_gpu 1`.", Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            // Each GPU has its own gate and its own last results, so a skipped frame would reuse the keypoints of an older frame (the last
+            // one sent to that GPU) rather than the ones of the previous frame
+            if (wrapperStructPose.motionGateThreshold > 0.f && gpuNumber > 1)
+                error("The motion gate cannot be combined with several GPUs, use `num_gpu 1`.", __LINE__, __FUNCTION__, __FILE__);
 
             // Proper format
             const auto writeImagesCleaned = formatAsDirectory(wrapperStructOutput.writeImages);
@@ -536,6 +595,9 @@ namespace op
                 // 2. Set finalOutputSize
                 producerSize = Point<int>{(int)wrapperStructInput.producerSharedPtr->get(CV_CAP_PROP_FRAME_WIDTH),
                                         (int)wrapperStructInput.producerSharedPtr->get(CV_CAP_PROP_FRAME_HEIGHT)};
+                if (!wrapperStructInput.roiMask.empty() && producerSize.area() > 0
+                    && (wrapperStructInput.roiMask.cols != producerSize.x || wrapperStructInput.roiMask.rows != producerSize.y))
+                    error("The ROI mask and the producer frames must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
                 if (wrapperStructPose.outputSize.x == -1 || wrapperStructPose.outputSize.y == -1)
                 {
                     if (producerSize.area() > 0)
@@ -553,11 +615,44 @@ namespace op
                 error(message, __LINE__, __FUNCTION__, __FILE__);
             }
 
+            // Flip and rotation fused into the GPU output resize (CvMatToOpOutput) rather than applied by the producer. Only if the output
+            // is rendered, otherwise Datum::cvOutputData would keep the unrotated frame. Not with pose tracking either, the tracker reads
+            // Datum::cvOutputData before it is rendered (i.e. the unrotated frame)
+            const auto fuseFlipAndRotation = (wrapperStructInput.producerSharedPtr != nullptr && renderOutput
+                                              && wrapperStructPose.keyframeInterval <= 1
+                                              && (wrapperStructInput.frameFlip || wrapperStructInput.frameRotate != 0));
+
+            // Reduced JPEG decoding (image directory). Only if every consumer of Datum::cvInputData downsamples it to the net input or
+            // output resolution, i.e. not with face, hand, person ROI, tiles, cascade nor ROI mask (full resolution crops or fixed size mask)
+            const auto reducedDecoding = (wrapperStructInput.producerSharedPtr != nullptr
+                                          && wrapperStructInput.producerSharedPtr->getType() == ProducerType::ImageDirectory
+                                          && !wrapperStructFace.enable && !wrapperStructHand.enable && wrapperStructInput.roiMask.empty()
+                                          && wrapperStructPose.roiFullFrameInterval == 0 && wrapperStructPose.tileScale <= 0.f
+                                          && wrapperStructPose.cascadeMaxHeight <= 0.f);
+            if (reducedDecoding)
+            {
+                const auto imageDirectoryReader = std::dynamic_pointer_cast<ImageDirectoryReader>(wrapperStructInput.producerSharedPtr);
+                if (imageDirectoryReader != nullptr)
+                {
+                    auto netInputSizes = std::vector<Point<int>>{wrapperStructPose.netInputSize};
+                    if (wrapperStructPose.latencyBudget > 0.f)
+                        netInputSizes.insert(netInputSizes.end(), wrapperStructPose.latencyNetInputSizes.begin(),
+                                             wrapperStructPose.latencyNetInputSizes.end());
+                    // The dynamic net input width only constrains the height
+                    std::vector<Point<int>> targetResolutions{finalOutputSize};
+                    for (const auto& netInputSize : netInputSizes)
+                        targetResolutions.emplace_back(Point<int>{(wrapperStructPose.dynamicNetInputWidth ? -1 : netInputSize.x),
+                                                                  netInputSize.y});
+                    imageDirectoryReader->setReducedDecoding(targetResolutions);
+                }
+            }
+
             // Producer
             if (wrapperStructInput.producerSharedPtr != nullptr)
             {
                 const auto datumProducer = std::make_shared<DatumProducer<TDatums>>(
-                    wrapperStructInput.producerSharedPtr, wrapperStructInput.frameFirst, wrapperStructInput.frameLast, spVideoSeek
+                    wrapperStructInput.producerSharedPtr, wrapperStructInput.frameFirst, wrapperStructInput.frameLast, spVideoSeek,
+                    !fuseFlipAndRotation
                 );
                 wDatumProducer = std::make_shared<WDatumProducer<TDatumsPtr, TDatums>>(datumProducer);
             }
@@ -571,8 +666,11 @@ namespace op
                 poseExtractors.emplace_back(std::make_shared<PoseExtractorCaffe>(
                     wrapperStructPose.netInputSize, poseNetOutputSize, finalOutputSize, wrapperStructPose.scalesNumber,
                     wrapperStructPose.poseModel, wrapperStructPose.modelFolder, gpuId + gpuNumberStart,
-                    wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScale
+                    wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScale, wrapperStructPose.sparseHeatMaps,
+                    wrapperStructPose.parallelScales
                 ));
+            for (auto& poseExtractor : poseExtractors)
+                poseExtractor->setRoiMask(wrapperStructInput.roiMask);
 
             // Pose renderers
             std::vector<std::shared_ptr<PoseRenderer>> poseRenderers;
@@ -609,18 +707,84 @@ namespace op
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
-            // Input cvMat to OpenPose format
+            // Net input resolution controller (latency budget)
+            const auto netResolutionController = (wrapperStructPose.latencyBudget > 0.f
+                ? std::make_shared<NetResolutionController>(wrapperStructPose.latencyNetInputSizes, wrapperStructPose.netInputSize,
+                                                            wrapperStructPose.latencyBudget, wrapperStructPose.dynamicNetInputWidth)
+                : nullptr);
+
+            // Input cvMat to OpenPose format (net input and output frame in a single stage)
             const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(
-                wrapperStructPose.netInputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap
+                wrapperStructPose.netInputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap, wrapperStructInput.roiMask
             );
-            spWCvMatToOpInput = std::make_shared<WCvMatToOpInput<TDatumsPtr>>(cvMatToOpInput);
-            const auto cvMatToOpOutput = std::make_shared<CvMatToOpOutput>(finalOutputSize, renderOutput);
-            spWCvMatToOpOutput = std::make_shared<WCvMatToOpOutput<TDatumsPtr>>(cvMatToOpOutput);
+            // The face and hand crops reuse the image pyramid (only without ROI, otherwise it is relative to the ROI bounding box)
+            const auto inputPyramid = (wrapperStructFace.enable || wrapperStructHand.enable) && wrapperStructInput.roiMask.empty();
+            const auto cvMatToOpOutput = (fuseFlipAndRotation
+                ? std::make_shared<CvMatToOpOutput>(finalOutputSize, renderOutput, wrapperStructInput.frameFlip,
+                                                    wrapperStructInput.frameRotate)
+                : std::make_shared<CvMatToOpOutput>(finalOutputSize, renderOutput));
+            spWCvMatToOpInputOutput = std::make_shared<WCvMatToOpInputOutput<TDatumsPtr>>(cvMatToOpInput, cvMatToOpOutput,
+                                                                                          netResolutionController, inputPyramid,
+                                                                                          wrapperStructPose.dynamicNetInputWidth);
 
             // Pose extractor(s)
             spWPoses.resize(poseExtractors.size());
             for (auto i = 0; i < spWPoses.size(); i++)
-                spWPoses.at(i) = {std::make_shared<WPoseExtractor<TDatumsPtr>>(poseExtractors.at(i))};
+            {
+                // Keyframe + optical flow tracking
+                if (wrapperStructPose.keyframeInterval > 1)
+                {
+                    const auto poseTracker = std::make_shared<PoseTracker>(
+                        wrapperStructPose.keyframeInterval, wrapperStructPose.trackingMinRatio, wrapperStructPose.trackingMaxError
+                    );
+                    spWPoses.at(i) = {std::make_shared<WPoseExtractorTracking<TDatumsPtr>>(poseExtractors.at(i), poseTracker)};
+                }
+                // Person ROI cropping
+                else if (wrapperStructPose.roiFullFrameInterval > 0)
+                {
+                    const auto poseExtractorRoi = std::make_shared<PoseExtractorRoi>(
+                        poseExtractors.at(i), wrapperStructPose.netInputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap,
+                        wrapperStructPose.roiFullFrameInterval, wrapperStructPose.roiPadding
+                    );
+                    spWPoses.at(i) = {std::make_shared<WPoseExtractorRoi<TDatumsPtr>>(poseExtractorRoi)};
+                }
+                // Overlapping tiles (very high resolution inputs)
+                else if (wrapperStructPose.tileScale > 0.f)
+                {
+                    const auto poseExtractorTiled = std::make_shared<PoseExtractorTiled>(
+                        poseExtractors.at(i), wrapperStructPose.netInputSize, wrapperStructPose.scalesNumber, wrapperStructPose.scaleGap,
+                        wrapperStructPose.tileScale, wrapperStructPose.tileOverlap
+                    );
+                    spWPoses.at(i) = {std::make_shared<WPoseExtractorTiled<TDatumsPtr>>(poseExtractorTiled)};
+                }
+                // Two-stage cascade (upscaled crops around the small people)
+                else if (wrapperStructPose.cascadeMaxHeight > 0.f)
+                {
+                    const auto poseExtractorCascade = std::make_shared<PoseExtractorCascade>(
+                        poseExtractors.at(i), wrapperStructPose.netInputSize, wrapperStructPose.poseModel, wrapperStructPose.scalesNumber,
+                        wrapperStructPose.scaleGap, wrapperStructPose.cascadeMaxHeight, wrapperStructPose.cascadeMaxCrops
+                    );
+                    spWPoses.at(i) = {std::make_shared<WPoseExtractorCascade<TDatumsPtr>>(poseExtractorCascade)};
+                }
+                // Network on every frame
+                else
+                    spWPoses.at(i) = {std::make_shared<WPoseExtractor<TDatumsPtr>>(poseExtractors.at(i), netResolutionController,
+                                                                                   wrapperStructPose.dynamicNetInputWidth)};
+                // Motion gate (1 per GPU, it must be placed before the pose extractor)
+                if (wrapperStructPose.motionGateThreshold > 0.f)
+                {
+                    const auto motionGate = std::make_shared<MotionGate>(wrapperStructPose.motionGateThreshold,
+                                                                         wrapperStructPose.motionGateMaxSkips);
+                    spWPoses.at(i).insert(spWPoses.at(i).begin(), std::make_shared<WMotionGate<TDatumsPtr>>(motionGate));
+                }
+            }
+
+            // Face and hand person selector
+            const auto personSelector = (wrapperStructPose.faceHandMaxPeople > 0
+                ? std::make_shared<PersonSelector>(wrapperStructPose.faceHandMaxPeople, wrapperStructPose.faceHandPersonPriority,
+                                                   wrapperStructPose.faceHandPointOfInterest,
+                                                   wrapperStructPose.faceHandPriorityFunction)
+                : nullptr);
 
             // Face extractor(s)
             if (wrapperStructFace.enable)
@@ -635,7 +799,12 @@ namespace op
                     const auto faceExtractor = std::make_shared<FaceExtractor>(
                         wrapperStructFace.netInputSize, netOutputSize, wrapperStructPose.modelFolder, gpuId + gpuNumberStart
                     );
-                    spWPoses.at(gpuId).emplace_back(std::make_shared<WFaceExtractor<TDatumsPtr>>(faceExtractor));
+                    // Face keypoint cache (1 per extractor, each one only sees the frames of its GPU)
+                    const auto faceKeypointCache = (wrapperStructFace.cacheMinIou > 0.f
+                        ? std::make_shared<FaceKeypointCache>(wrapperStructFace.cacheMinIou, wrapperStructFace.cacheRefreshInterval)
+                        : nullptr);
+                    spWPoses.at(gpuId).emplace_back(std::make_shared<WFaceExtractor<TDatumsPtr>>(faceExtractor, personSelector,
+                                                                                                 faceKeypointCache));
                 }
             }
 
@@ -660,7 +829,7 @@ namespace op
                         (wrapperStructHand.detectionMode == DetectionMode::Iterative
                             || wrapperStructHand.detectionMode == DetectionMode::IterativeAndTracking)
                     );
-                    spWPoses.at(gpuId).emplace_back(std::make_shared<WHandExtractor<TDatumsPtr>>(handExtractor));
+                    spWPoses.at(gpuId).emplace_back(std::make_shared<WHandExtractor<TDatumsPtr>>(handExtractor, personSelector));
                     // If tracking
                     if (wrapperStructHand.detectionMode == DetectionMode::Tracking
                             || wrapperStructHand.detectionMode == DetectionMode::IterativeAndTracking)
@@ -759,7 +928,7 @@ namespace op
             }
             // Re-scale pose if desired
             if (wrapperStructPose.keypointScale != ScaleMode::OutputResolution
-                && (wrapperStructPose.keypointScale != ScaleMode::InputResolution || (finalOutputSize != producerSize))
+                && (wrapperStructPose.keypointScale != ScaleMode::InputResolution || (finalOutputSize != producerSize) || reducedDecoding)
                 && (wrapperStructPose.keypointScale != ScaleMode::NetOutputResolution || (finalOutputSize != poseNetOutputSize)))
             {
                 auto keypointScaler = std::make_shared<KeypointScaler>(wrapperStructPose.keypointScale);
@@ -1005,8 +1174,7 @@ namespace op
             // Reset 
             mUserInputWs.clear();
             wDatumProducer = nullptr;
-            spWCvMatToOpInput = nullptr;
-            spWCvMatToOpOutput = nullptr;
+            spWCvMatToOpInputOutput = nullptr;
             spWPoses.clear();
             mPostProcessingWs.clear();
             mUserPostProcessingWs.clear();
@@ -1028,7 +1196,7 @@ namespace op
             // The less number of queues -> the less lag
 
             // Security checks
-            if (spWCvMatToOpInput == nullptr || spWCvMatToOpOutput == nullptr)
+            if (spWCvMatToOpInputOutput == nullptr)
                 error("Configure the Wrapper class before calling `start()`.", __LINE__, __FUNCTION__, __FILE__);
             if ((wDatumProducer == nullptr) == (mUserInputWs.empty())
                 && mThreadManagerMode != ThreadManagerMode::Asynchronous && mThreadManagerMode != ThreadManagerMode::AsynchronousIn)
@@ -1056,7 +1224,7 @@ namespace op
             {
                 mThreadManager.add(mThreadId, mUserInputWs, queueIn++, queueOut++);                     // Thread 0, queues 0 -> 1
                 threadIdPP();
-                mThreadManager.add(mThreadId, {spWIdGenerator, spWCvMatToOpInput, spWCvMatToOpOutput}, queueIn++, queueOut++); // Thread 1, queues 1 -> 2
+                mThreadManager.add(mThreadId, {spWIdGenerator, spWCvMatToOpInputOutput}, queueIn++, queueOut++);      // Thread 1, queues 1 -> 2
             }
             // If custom user Worker in same thread or producer on same thread
             else
@@ -1072,7 +1240,7 @@ namespace op
                 else if (mThreadManagerMode != ThreadManagerMode::Asynchronous && mThreadManagerMode != ThreadManagerMode::AsynchronousIn)
                     error("No input selected.", __LINE__, __FUNCTION__, __FILE__);
 
-                workersAux = mergeWorkers(workersAux, {spWIdGenerator, spWCvMatToOpInput, spWCvMatToOpOutput});
+                workersAux = mergeWorkers(workersAux, {spWIdGenerator, spWCvMatToOpInputOutput});
                 mThreadManager.add(mThreadId, workersAux, queueIn++, queueOut++);                       // Thread 0 or 1, queues 0 -> 1
             }
             threadIdPP();
@@ -45,6 +45,17 @@ namespace op
 		*/
 		float alphaHeatMap;
 
+		/**
+		* Minimum IoU between the rectangle of a face and the one of the previous frame to reuse its previous keypoints instead of
+		* running the face network on it (see FaceKeypointCache). Value in the range [0, 1]. 0 disables it (e.g. 0.9 for static cameras).
+		*/
+		float cacheMinIou;
+
+		/**
+		* Maximum number of consecutive frames a face can reuse its keypoints. No effect if cacheMinIou == 0.
+		*/
+		int cacheRefreshInterval;
+
 		/**
 		* Constructor of the struct.
 		* It has the recommended and default values we recommend for each element of the struct.
@@ -53,7 +64,8 @@ namespace op
 		OPENPOSE_API WrapperStructFace(const bool enable = false, const Point<int>& netInputSize = Point<int>{ 368, 368 },
 			const RenderMode renderMode = RenderMode::None,
 			const float alphaKeypoint = FACE_DEFAULT_ALPHA_KEYPOINT,
-			const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP);
+			const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP,
+			const float cacheMinIou = 0.f, const int cacheRefreshInterval = 10);
 	};
 }
 
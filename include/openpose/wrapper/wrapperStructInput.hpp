@@ -2,6 +2,7 @@
 #define OPENPOSE_WRAPPER_WRAPPER_STRUCT_INPUT_HPP
 
 #include <memory>
+#include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/producer/producer.hpp>
 #include "../config.hpp"
 
@@ -52,6 +53,14 @@ namespace op
          */
         bool framesRepeat;
 
+        /**
+         * Static region of interest of the stream (e.g. to skip sky, walls or overlays that never contain people).
+         * 1-channel 8-bit image with the resolution of the frames, where non-zero pixels are the useful area. Only the bounding box of the
+         * mask is sent to the body network, and body parts outside the mask are ignored. Keypoints are still given in full frame coordinates.
+         * Default: empty (i.e. whole frame). Not compatible with WrapperStructPose::roiFullFrameInterval > 0 nor tileScale > 0.
+         */
+        cv::Mat roiMask;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -59,7 +68,7 @@ namespace op
          */
 		OPENPOSE_API WrapperStructInput(const std::shared_ptr<Producer> producerSharedPtr = nullptr, const unsigned long long frameFirst = 0,
                            const unsigned long long frameLast = -1, const bool realTimeProcessing = false, const bool frameFlip = false,
-                           const int frameRotate = 0, const bool framesRepeat = false);
+                           const int frameRotate = 0, const bool framesRepeat = false, const cv::Mat& roiMask = cv::Mat{});
     };
 }
 
@@ -6,6 +6,7 @@
 #include "../pose/enumClasses.hpp"
 #include "../pose/poseParameters.hpp"
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/personSelector.hpp>
 #include <openpose/core/point.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseParameters.hpp>
@@ -127,6 +128,136 @@ namespace op
          */
         ScaleMode heatMapScale;
 
+        /**
+         * Keyframe interval for the pose tracking mode (video and webcam).
+         * The body network only runs every `keyframeInterval` frames (or whenever the tracking is lost), and the poseKeypoints are propagated
+         * with sparse optical flow on the frames in between. 1 disables tracking, i.e. the network runs on every frame.
+         * Frames must arrive in order, so it should only be used with 1 GPU.
+         */
+        int keyframeInterval;
+
+        /**
+         * Minimum ratio of keypoints successfully tracked between 2 frames. Below it, the tracking is considered lost and the network is run.
+         * No effect if keyframeInterval == 1.
+         */
+        float trackingMinRatio;
+
+        /**
+         * Maximum optical flow (Lucas-Kanade) error of a keypoint to consider it successfully tracked.
+         * No effect if keyframeInterval == 1.
+         */
+        float trackingMaxError;
+
+        /**
+         * Person ROI mode: the body network only processes the padded union of the people bounding boxes found in the previous frame (at
+         * equal or higher effective resolution), and the full frame every `roiFullFrameInterval` frames in order to detect new people.
+         * 0 disables it. Frames must arrive in order, so it should only be used with 1 GPU. Not compatible with keyframeInterval > 1.
+         */
+        int roiFullFrameInterval;
+
+        /**
+         * Padding added to each side of the person ROI, relative to its biggest side. No effect if roiFullFrameInterval == 0.
+         */
+        float roiPadding;
+
+        /**
+         * Motion gate threshold: maximum mean absolute difference (range [0, 255]) between a downscaled grayscale version of the frame and the
+         * last processed one to consider the frame static. On static frames, the pose, face and hand networks are skipped and the last
+         * keypoints reused (Datum::inferenceSkipped is set to true). 0 disables it. Not compatible with keyframeInterval > 1 nor with
+         * several GPUs.
+         */
+        float motionGateThreshold;
+
+        /**
+         * Maximum number of consecutive frames skipped by the motion gate. No effect if motionGateThreshold == 0.
+         */
+        int motionGateMaxSkips;
+
+        /**
+         * Tiled mode for very high resolution inputs (e.g. 4K or 8K): the frame is split into overlapping tiles of `netInputSize` at
+         * `tileScale` times the original resolution (1 = original resolution), processed as a single network batch, and their heat maps
+         * and PAFs are merged before connecting the body parts (see PoseExtractorTiled). 0 disables it. Not compatible with
+         * keyframeInterval > 1, roiFullFrameInterval > 0 nor parallelScales.
+         */
+        float tileScale;
+
+        /**
+         * Overlap between consecutive tiles, relative to the tile size. The tiles fade towards their borders in the merged heat maps, so
+         * the overlap gives the network context around the seams. No effect if tileScale == 0.
+         */
+        float tileOverlap;
+
+        /**
+         * Two-stage cascade: after the whole frame pass, the people whose height is below `cascadeMaxHeight` times the frame height are
+         * processed again on an upscaled crop around them, and their keypoints replaced. It lets a low `netInputSize` keep most of the
+         * accuracy on small (distant) people. 0 disables it. Not compatible with keyframeInterval > 1, roiFullFrameInterval > 0 nor
+         * tileScale > 0.
+         */
+        float cascadeMaxHeight;
+
+        /**
+         * Maximum number of crops (i.e. extra network passes) per frame of the cascade, the smallest people first. No effect if
+         * cascadeMaxHeight == 0.
+         */
+        int cascadeMaxCrops;
+
+        /**
+         * Latency budget (in milliseconds) per frame, from the producer to the pose output. If the average latency exceeds it, the net input
+         * resolution steps down among `latencyNetInputSizes` (and it steps up again when there is enough margin). The resolution used for
+         * each frame is reported in Datum::netInputSize. 0 disables it. Not compatible with keyframeInterval > 1, roiFullFrameInterval > 0,
+         * tileScale > 0 nor cascadeMaxHeight > 0.
+         */
+        float latencyBudget;
+
+        /**
+         * Net input resolutions for the latency budget, sorted from the highest to the lowest one. It must contain `netInputSize`, which is
+         * the initial one. No effect if latencyBudget == 0.
+         */
+        std::vector<Point<int>> latencyNetInputSizes;
+
+        /**
+         * Maximum number of people per frame processed by the face and hand networks (the remaining ones get their keypoints scores set to
+         * KEYPOINT_NOT_EVALUATED_SCORE). 0 evaluates everybody.
+         */
+        int faceHandMaxPeople;
+
+        /**
+         * Criterion to select the `faceHandMaxPeople` people. No effect if faceHandMaxPeople == 0.
+         */
+        PersonPriority faceHandPersonPriority;
+
+        /**
+         * Point of interest (in output resolution coordinates) for PersonPriority::Distance.
+         */
+        Point<float> faceHandPointOfInterest;
+
+        /**
+         * User-defined priority for PersonPriority::Callback.
+         */
+        PersonSelector::PriorityFunction faceHandPriorityFunction;
+
+        /**
+         * Whether to only resize the body part heat maps around the areas that can contain peaks (the rest is set to 0). The keypoints do
+         * not change. Only applied with 1 scale and no heatMapTypes (the rendered body part heat maps are 0 in the cold areas). Only the
+         * resize is sparse, NMS remains dense.
+         */
+        bool sparseHeatMaps;
+
+        /**
+         * Whether to run each scale (if scalesNumber > 1) concurrently on the CPU, each one with its own network instance (sharing the
+         * weights), instead of as a single batch on the GPU. For many-core hosts, ideally limiting the BLAS threads (e.g.
+         * OPENBLAS_NUM_THREADS) to the number of cores divided by scalesNumber.
+         */
+        bool parallelScales;
+
+        /**
+         * Whether to adapt the net input width of each frame to its aspect ratio (rounded up to a multiple of 16), keeping the height of
+         * `netInputSize` (e.g. portrait or 4:3 videos do not waste network computation on padding). The resolution used for each frame
+         * is reported in Datum::netInputSize. Not compatible with keyframeInterval > 1, roiFullFrameInterval > 0, tileScale > 0 nor
+         * cascadeMaxHeight > 0.
+         */
+        bool dynamicNetInputWidth;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -138,7 +269,18 @@ namespace op
 		                  const PoseModel poseModel = PoseModel::COCO_18, const bool blendOriginalFrame = true,
                           const float alphaKeypoint = POSE_DEFAULT_ALPHA_KEYPOINT, const float alphaHeatMap = POSE_DEFAULT_ALPHA_HEAT_MAP,
                           const int defaultPartToRender = 0, const std::string& modelFolder = "models/",
-                          const std::vector<HeatMapType>& heatMapTypes = {}, const ScaleMode heatMapScale = ScaleMode::ZeroToOne);
+                          const std::vector<HeatMapType>& heatMapTypes = {}, const ScaleMode heatMapScale = ScaleMode::ZeroToOne,
+                          const int keyframeInterval = 1, const float trackingMinRatio = POSE_DEFAULT_TRACKING_MIN_RATIO,
+                          const float trackingMaxError = POSE_DEFAULT_TRACKING_MAX_ERROR, const int roiFullFrameInterval = 0,
+                          const float roiPadding = 0.2f, const float motionGateThreshold = 0.f, const int motionGateMaxSkips = 30,
+                          const float tileScale = 0.f, const float tileOverlap = 0.25f,
+                          const float cascadeMaxHeight = 0.f, const int cascadeMaxCrops = 4, const float latencyBudget = 0.f,
+                          const std::vector<Point<int>>& latencyNetInputSizes = {}, const int faceHandMaxPeople = 0,
+                          const PersonPriority faceHandPersonPriority = PersonPriority::Area,
+                          const Point<float>& faceHandPointOfInterest = Point<float>{},
+                          const PersonSelector::PriorityFunction& faceHandPriorityFunction = nullptr,
+                          const bool sparseHeatMaps = false, const bool parallelScales = false,
+                          const bool dynamicNetInputWidth = false);
     };
 }
 
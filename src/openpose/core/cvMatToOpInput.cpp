@@ -12,33 +12,49 @@
 #include "openpose/core/cvMatToOpInput.hpp"
 #include "openpose/utilities/cuda.hpp"
 
+#include <algorithm> // std::find_if, std::max
 #include <numeric> // std::accumulate
 
 
 namespace op
 {
-    CvMatToOpInput::CvMatToOpInput(const Point<int>& netInputResolution, const int scaleNumber, const float scaleGap) :
+    inline bool isPyramidFree(const std::vector<cv::cuda::GpuMat>& inputPyramid)
+    {
+        try
+        {
+            // Free if no level is referenced outside the pool
+            for (const auto& level : inputPyramid)
+                if (level.refcount != nullptr && *level.refcount > 1)
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    CvMatToOpInput::CvMatToOpInput(const Point<int>& netInputResolution, const int scaleNumber, const float scaleGap,
+                                   const cv::Mat& roiMask) :
         mScaleNumber{scaleNumber},
         mScaleGap{scaleGap},
         mInputNetSize4D{{mScaleNumber, 3, netInputResolution.y, netInputResolution.x}},
-		scaledInputData { new cv::cuda::GpuMat()}
+        mRoiMaskSize{roiMask.size()},
+        mRoi{getMaskBoundingBox(roiMask)}
     {
         try
         {
             // Security checks
             if (netInputResolution.x % 16 != 0 || netInputResolution.y % 16 != 0)
                 error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            if (!roiMask.empty() && mRoi.area() == 0)
+                error("The ROI mask does not contain any non-zero pixel.", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
-		
-    }
-
-	CvMatToOpInput::~CvMatToOpInput() {
-		delete scaledInputData;
-		
     }
 
     std::pair<Array<float>, std::vector<float>> CvMatToOpInput::format(const cv::Mat& cvInputData) const
@@ -48,11 +64,19 @@ namespace op
             // Security checks
             if (cvInputData.empty())
                 error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+            if (mRoi.area() > 0 && cvInputData.size() != mRoiMaskSize)
+                error("The ROI mask and the input frames must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Static ROI - Only the bounding box of the mask is sent to the network
+            const cv::Mat cvInputDataRoi = (mRoi.area() > 0 ? cvInputData(mRoi) : cvInputData);
 
             // inputNetData - Reescale keeping aspect ratio and transform to float the input deep net image
-            Array<float> inputNetData{mInputNetSize4D};
+            Array<float> inputNetData = mInputNetDataPool.get(mInputNetSize4D);
             std::vector<float> scaleRatios(mScaleNumber, 1.f);
             const auto inputNetDataOffset = inputNetData.getVolume(1, 3);
+            // Image pyramid - Each scale is resampled from the previous (already reduced) one
+            std::vector<cv::Mat> inputPyramid(mScaleNumber);
+            mFramesWithNetSize.resize(mScaleNumber);
             for (auto i = 0; i < mScaleNumber; i++)
             {
                 const auto currentScale = 1.f - i*mScaleGap;
@@ -64,8 +88,22 @@ namespace op
                 const auto netInputHeight = inputNetData.getSize(2);
                 const auto targetHeight  = fastTruncate(intRound(netInputHeight * currentScale) / 16 * 16, 1, netInputHeight);
                 const Point<int> targetSize{targetWidth, targetHeight};
-                const auto scale = resizeGetScaleFactor(Point<int>{cvInputData.cols, cvInputData.rows}, targetSize);
-                const cv::Mat frameWithNetSize = resizeFixedAspectRatio(cvInputData, scale, Point<int>{netInputWidth, netInputHeight});
+                const auto scale = resizeGetScaleFactor(Point<int>{cvInputDataRoi.cols, cvInputDataRoi.rows}, targetSize);
+                const cv::Size levelSize{fastTruncate(intRound(scale * cvInputDataRoi.cols), 1, netInputWidth),
+                                         fastTruncate(intRound(scale * cvInputDataRoi.rows), 1, netInputHeight)};
+                // Only the first level reads the full resolution frame. Downscaling uses area interpolation (antialiased)
+                const cv::Mat& source = (i == 0 ? cvInputDataRoi : inputPyramid[i-1]);
+                // Padded buffer reused between frames, only the padding is cleared
+                cv::Mat& frameWithNetSize = mFramesWithNetSize[i];
+                frameWithNetSize.create(netInputHeight, netInputWidth, cvInputDataRoi.type());
+                frameWithNetSize(cv::Rect{levelSize.width, 0, netInputWidth - levelSize.width, netInputHeight}).setTo(0);
+                frameWithNetSize(cv::Rect{0, levelSize.height, levelSize.width, netInputHeight - levelSize.height}).setTo(0);
+                inputPyramid[i] = frameWithNetSize(cv::Rect{cv::Point{0,0}, levelSize});
+                if (levelSize == source.size())
+                    source.copyTo(inputPyramid[i]);
+                else
+                    cv::resize(source, inputPyramid[i], levelSize, 0, 0,
+                               (levelSize.width <= source.cols && levelSize.height <= source.rows ? cv::INTER_AREA : cv::INTER_CUBIC));
                 // Fill inputNetData
                 uCharCvMatToFloatPtr(inputNetData.getPtr() + i * inputNetDataOffset, frameWithNetSize, true);
                 // Fill scaleRatios
@@ -83,35 +121,98 @@ namespace op
         }
     }
 
-	std::vector<float> CvMatToOpInput::format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData) const
+	std::vector<float> CvMatToOpInput::format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData, const bool frameFlip,
+	                                          const int frameRotation) const
+	{
+		try
+		{
+			return formatPyramid(gpuArray, cvInputData, mInputPyramid, mInputPyramidScales, frameFlip, frameRotation);
+		}
+		catch (const std::exception& e)
+		{
+			error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+			return std::vector<float>{};
+		}
+	}
+
+    std::vector<float> CvMatToOpInput::format(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData,
+                                              std::vector<cv::cuda::GpuMat>& inputPyramid, std::vector<double>& inputPyramidScales,
+                                              const bool frameFlip, const int frameRotation) const
+    {
+        try
+        {
+            // Recycled levels not referenced by any previous Datum, the caller keeps a reference to them
+            auto freePyramid = std::find_if(mInputPyramidPool.begin(), mInputPyramidPool.end(), isPyramidFree);
+            if (freePyramid == mInputPyramidPool.end())
+            {
+                mInputPyramidPool.emplace_back();
+                freePyramid = mInputPyramidPool.end() - 1;
+            }
+            inputPyramid = *freePyramid;
+            const auto scaleRatios = formatPyramid(gpuArray, cvInputData, inputPyramid, inputPyramidScales, frameFlip, frameRotation);
+            // Keep the (possibly reallocated) levels in the pool
+            *freePyramid = inputPyramid;
+            return scaleRatios;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::vector<float>{};
+        }
+    }
+
+	std::vector<float> CvMatToOpInput::formatPyramid(GpuArray<float>& gpuArray, const cv::cuda::GpuMat& cvInputData,
+                                                     std::vector<cv::cuda::GpuMat>& inputPyramid, std::vector<double>& inputPyramidScales,
+                                                     const bool frameFlip, const int frameRotation) const
 	{
 		try
 		{
 			// Security checks
 			if (cvInputData.empty())
 				error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+			if (mRoi.area() > 0 && cvInputData.size() != mRoiMaskSize)
+				error("The ROI mask and the input frames must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
+			if (mRoi.area() > 0 && (frameFlip || frameRotation != 0))
+				error("The ROI mask requires the input frames already flipped and rotated.", __LINE__, __FUNCTION__, __FILE__);
 
-			if ( gpuArray.empty()) {
-				gpuArray.reset(mInputNetSize4D);
-			}
+			// Static ROI - Only the bounding box of the mask is sent to the network
+			const cv::cuda::GpuMat cvInputDataRoi = (mRoi.area() > 0 ? cvInputData(mRoi) : cvInputData);
+			// Flipped and rotated input resolution
+			const auto transpose = (frameRotation == 90 || frameRotation == 270);
+			const Point<int> inputSize{(transpose ? cvInputDataRoi.rows : cvInputDataRoi.cols),
+			                           (transpose ? cvInputDataRoi.cols : cvInputDataRoi.rows)};
+
+			// Recycled buffer not referenced by any previous Datum
+			gpuArray = mInputNetDataGpuPool.get(mInputNetSize4D);
 
-			Array<float> inputNetData{ mInputNetSize4D };
 			std::vector<float> scaleRatios(mScaleNumber, 1.f);
-			const auto inputNetDataOffset = inputNetData.getVolume(1, 3);
+			const auto inputNetDataOffset = gpuArray.getVolume(1, 3);
+			// Image pyramid - Each scale is resampled from the previous (already reduced) one
+			inputPyramid.resize(mScaleNumber);
+			inputPyramidScales.resize(mScaleNumber);
 			for (auto i = 0; i < mScaleNumber; i++)
 			{
 				const auto currentScale = 1.f - i*mScaleGap;
 				if (currentScale < 0.f || 1.f < currentScale)
 					error("All scales must be in the range [0, 1], i.e. 0 <= 1-num_scales*scale_gap <= 1", __LINE__, __FUNCTION__, __FILE__);
 
-				const auto netInputWidth = inputNetData.getSize(3);
+				const auto netInputWidth = gpuArray.getSize(3);
 				const auto targetWidth = fastTruncate(intRound(netInputWidth * currentScale) / 16 * 16, 1, netInputWidth);
-				const auto netInputHeight = inputNetData.getSize(2);
+				const auto netInputHeight = gpuArray.getSize(2);
 				const auto targetHeight = fastTruncate(intRound(netInputHeight * currentScale) / 16 * 16, 1, netInputHeight);
 				const Point<int> targetSize{ targetWidth, targetHeight };
-				const auto scale = resizeGetScaleFactor(Point<int>{cvInputData.cols, cvInputData.rows}, targetSize);
-				resizeFixedAspectRatioGpu(cvInputData, *scaledInputData, scale, Point<int>{ netInputWidth, netInputHeight });
-				uCharGpuMatToFloatPtr(gpuArray.getPtr(), *scaledInputData, true, i * inputNetDataOffset);
+				const auto scale = resizeGetScaleFactor(inputSize, targetSize);
+				const cv::Size levelSize{ fastTruncate(intRound(scale * inputSize.x), 1, netInputWidth),
+				                          fastTruncate(intRound(scale * inputSize.y), 1, netInputHeight) };
+				// Only the first level reads the full resolution frame (and flips and rotates it). Downscaling uses area interpolation
+				// (antialiased)
+				const cv::cuda::GpuMat& source = (i == 0 ? cvInputDataRoi : inputPyramid[i-1]);
+				// Fused resize + normalization + HWC to CHW, written directly into the net input
+				if (mResizers.size() < (unsigned int)mScaleNumber)
+					mResizers.resize(mScaleNumber);
+				mResizers[i].resize(gpuArray.getPtr(), &inputPyramid[i], source, levelSize, Point<int>{ netInputWidth, netInputHeight }, true,
+				                    i * inputNetDataOffset, (i == 0 && frameFlip), (i == 0 ? frameRotation : 0));
+				inputPyramidScales[i] = scale;
 				// Fill scaleRatios
 				scaleRatios[i] = { (float)scale };
 				if (i > 0)
@@ -128,4 +229,68 @@ namespace op
 		
 	}
 
+    Point<int> CvMatToOpInput::getNetInputSize() const
+    {
+        try
+        {
+            return Point<int>{mInputNetSize4D[3], mInputNetSize4D[2]};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    Point<int> CvMatToOpInput::getAspectRatioNetInputSize(const Point<int>& netInputResolution, const Point<int>& inputSize) const
+    {
+        try
+        {
+            // Static ROI - Only the bounding box of the mask is sent to the network
+            const Point<int> netInputDataSize = (mRoi.area() > 0 ? Point<int>{mRoi.width, mRoi.height} : inputSize);
+            // Security checks
+            if (netInputDataSize.x <= 0 || netInputDataSize.y <= 0)
+                error("Wrong input size.", __LINE__, __FUNCTION__, __FILE__);
+            if (netInputResolution.y % 16 != 0)
+                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            // Same height, width = height * aspect ratio, rounded up to a multiple of 16 (integer arithmetic, exact for e.g. 16:9)
+            const auto denominator = 16ll * netInputDataSize.y;
+            const auto netInputWidth = (int)((netInputResolution.y * (long long)netInputDataSize.x + denominator - 1) / denominator * 16);
+            return Point<int>{std::max(16, netInputWidth), netInputResolution.y};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    cv::Rect CvMatToOpInput::getRoi() const
+    {
+        try
+        {
+            return mRoi;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Rect{};
+        }
+    }
+
+    void CvMatToOpInput::setNetInputSize(const Point<int>& netInputResolution)
+    {
+        try
+        {
+            // Security checks
+            if (netInputResolution.x % 16 != 0 || netInputResolution.y % 16 != 0)
+                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            mInputNetSize4D[2] = netInputResolution.y;
+            mInputNetSize4D[3] = netInputResolution.x;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -1,18 +1,37 @@
 #include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/core/cvMatToOpOutput.hpp>
 
 namespace op
 {
-    CvMatToOpOutput::CvMatToOpOutput(const Point<int>& outputResolution, const bool generateOutput) :
-        mGenerateOutput{generateOutput},
-        mOutputSize3D{{3, outputResolution.y, outputResolution.x}},
-		scaledImage {new cv::cuda::GpuMat()}
+    inline cv::cuda::GpuMat& getFreeGpuMat(std::vector<cv::cuda::GpuMat>& gpuMats)
     {
+        // Free if not referenced outside the pool (e.g. by a previous Datum)
+        for (auto& gpuMat : gpuMats)
+            if (gpuMat.refcount == nullptr || *gpuMat.refcount <= 1)
+                return gpuMat;
+        gpuMats.emplace_back();
+        return gpuMats.back();
     }
 
-	CvMatToOpOutput::~CvMatToOpOutput() {
-		delete scaledImage;
+    CvMatToOpOutput::CvMatToOpOutput(const Point<int>& outputResolution, const bool generateOutput, const bool frameFlip,
+                                     const int frameRotation) :
+        mGenerateOutput{generateOutput},
+        mOutputSize3D{{3, outputResolution.y, outputResolution.x}},
+        mFrameFlip{frameFlip},
+        mFrameRotation{frameRotation}
+    {
+        try
+        {
+            // Security checks
+            if (frameRotation != 0 && frameRotation != 90 && frameRotation != 180 && frameRotation != 270)
+                error("Rotation angle != {0, 90, 180, 270} degrees.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::tuple<double, Array<float>> CvMatToOpOutput::format(const cv::Mat& cvInputData) const
@@ -22,16 +41,18 @@ namespace op
             // Security checks
             if (cvInputData.empty())
                 error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+            if (mFrameFlip || mFrameRotation != 0)
+                error("The fused flip and rotation are only implemented for GPU frames.", __LINE__, __FUNCTION__, __FILE__);
 
             // outputData - Reescale keeping aspect ratio and transform to float the output image
             const Point<int> outputResolution{mOutputSize3D[2], mOutputSize3D[1]};
             const double scaleInputToOutput = resizeGetScaleFactor(Point<int>{cvInputData.cols, cvInputData.rows}, outputResolution);
-            const cv::Mat frameWithOutputSize = resizeFixedAspectRatio(cvInputData, scaleInputToOutput, outputResolution);
             Array<float> outputData;
             if (mGenerateOutput)
             {
-                outputData.reset(mOutputSize3D);
-                uCharCvMatToFloatPtr(outputData.getPtr(), frameWithOutputSize, false);
+                resizeFixedAspectRatio(cvInputData, mFrameWithOutputSize, scaleInputToOutput, outputResolution);
+                outputData = mOutputDataPool.get(mOutputSize3D);
+                uCharCvMatToFloatPtr(outputData.getPtr(), mFrameWithOutputSize, false);
             }
 
             return std::make_tuple(scaleInputToOutput, outputData);
@@ -44,26 +65,10 @@ namespace op
     }
 
 	void  CvMatToOpOutput::format(const cv::cuda::GpuMat& cvInputData, float& scaleInputToOutput, GpuArray<float>& outputData) const {
-
-		
 		try
 		{
-			// Security checks
-			if (cvInputData.empty())
-				error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
-
-			// outputData - Reescale keeping aspect ratio and transform to float the output image
-			const Point<int> outputResolution{ mOutputSize3D[2], mOutputSize3D[1] };
-			scaleInputToOutput = resizeGetScaleFactor(Point<int>{cvInputData.cols, cvInputData.rows}, outputResolution);
-			resizeFixedAspectRatioGpu(cvInputData, *scaledImage, scaleInputToOutput, outputResolution);
-			if ( outputData.empty() ) {
-				outputData.reset(mOutputSize3D);
-			}
-
-			if (mGenerateOutput)
-			{	
-				uCharGpuMatToFloatPtr(outputData.getPtr(), *scaledImage, false);
-			}
+			cv::cuda::GpuMat outputImage;
+			format(cvInputData, scaleInputToOutput, outputData, outputImage);
 		}
 		catch (const std::exception& e)
 		{
@@ -71,4 +76,114 @@ namespace op
 			scaleInputToOutput = 0;
 		}
     }
+
+    void CvMatToOpOutput::format(const cv::cuda::GpuMat& cvInputData, float& scaleInputToOutput, GpuArray<float>& outputData,
+                                 cv::cuda::GpuMat& outputImage) const
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+
+            // Flipped and rotated input resolution
+            const auto transpose = (mFrameRotation == 90 || mFrameRotation == 270);
+            const auto flipAndRotate = (mFrameFlip || mFrameRotation != 0);
+            const Point<int> inputSize{(transpose ? cvInputData.rows : cvInputData.cols), (transpose ? cvInputData.cols : cvInputData.rows)};
+
+            // outputData - Reescale keeping aspect ratio and transform to float the output image
+            const Point<int> outputResolution{mOutputSize3D[2], mOutputSize3D[1]};
+            scaleInputToOutput = (float)resizeGetScaleFactor(inputSize, outputResolution);
+            // Recycled buffer not referenced by any previous Datum
+            outputData = mOutputDataGpuPool.get(mOutputSize3D);
+
+            if (mGenerateOutput)
+            {
+                const cv::Size outputImageSize{fastTruncate(intRound(scaleInputToOutput * inputSize.x), 1, outputResolution.x),
+                                               fastTruncate(intRound(scaleInputToOutput * inputSize.y), 1, outputResolution.y)};
+                // Same resolution (and no flip nor rotation) - The uchar frame is not copied
+                if (outputImageSize == cvInputData.size() && !flipAndRotate)
+                {
+                    outputImage = cvInputData;
+                    mResizer.resize(outputData.getPtr(), nullptr, cvInputData, outputImageSize, outputResolution, false);
+                }
+                // Resize, with the flip and rotation (if any) fused into the resampling (the unrotated frame is read once)
+                else
+                {
+                    // Same resolution - It will be the flipped and rotated cvInputData (flipAndRotate), so it is recycled with it
+                    cv::cuda::GpuMat* flippedAndRotatedInput = nullptr;
+                    if (flipAndRotate && outputImageSize == cv::Size{inputSize.x, inputSize.y})
+                    {
+                        flippedAndRotatedInput = &getFreeGpuMat(mFlippedAndRotatedInputs);
+                        outputImage = *flippedAndRotatedInput;
+                    }
+                    mResizer.resize(outputData.getPtr(), &outputImage, cvInputData, outputImageSize, outputResolution, false, 0,
+                                    mFrameFlip, mFrameRotation);
+                    // Keep the (possibly reallocated) buffer in the pool
+                    if (flippedAndRotatedInput != nullptr)
+                        *flippedAndRotatedInput = outputImage;
+                }
+            }
+            else
+                outputImage = cv::cuda::GpuMat{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            scaleInputToOutput = 0;
+        }
+    }
+
+    void CvMatToOpOutput::flipAndRotate(cv::cuda::GpuMat& cvInputData, const cv::cuda::GpuMat& outputImage) const
+    {
+        try
+        {
+            if (mFrameFlip || mFrameRotation != 0)
+            {
+                const auto transpose = (mFrameRotation == 90 || mFrameRotation == 270);
+                const cv::Size inputSize{(transpose ? cvInputData.rows : cvInputData.cols),
+                                         (transpose ? cvInputData.cols : cvInputData.rows)};
+                // Output frame with the input resolution - Already flipped and rotated by format()
+                if (outputImage.size() == inputSize)
+                    cvInputData = outputImage;
+                // Otherwise, 1 GPU copy into a recycled buffer (the unrotated frame buffer belongs to the producer)
+                else
+                {
+                    auto& flippedAndRotatedInput = getFreeGpuMat(mFlippedAndRotatedInputs);
+                    flipAndRotateGpu(cvInputData, flippedAndRotatedInput, mFrameFlip, mFrameRotation);
+                    cvInputData = flippedAndRotatedInput;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool CvMatToOpOutput::getFrameFlip() const
+    {
+        try
+        {
+            return mFrameFlip;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    int CvMatToOpOutput::getFrameRotation() const
+    {
+        try
+        {
+            return mFrameRotation;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
 }
@@ -56,6 +56,55 @@ namespace op {
 
 	}
 	
+	__global__ void resizeToFloatKernel(float* floatImage, unsigned char* levelData, const unsigned long levelStep, const unsigned char* imgData,
+		const int channels, const unsigned long xStride, const unsigned long yStride, const int levelWidth, const int levelHeight,
+		const int netWidth, const int netHeight,
+		const int* xIndexes, const float* xWeights, const int xTaps, const int* yIndexes, const float* yWeights, const int yTaps,
+		const bool normalize)
+	{
+		const auto x = (int)((blockIdx.x * blockDim.x) + threadIdx.x);
+		const auto y = (int)((blockIdx.y * blockDim.y) + threadIdx.y);
+
+		if (x >= netWidth || y >= netHeight)
+		{
+			return;
+		}
+
+		const auto channelOffset = netWidth * netHeight;
+		float* floatPtr = floatImage + y * netWidth + x;
+		// Padding - Constant black value, nothing is resampled
+		if (x >= levelWidth || y >= levelHeight)
+		{
+			const auto value = (normalize ? -0.5f : 0.f);
+			for (auto c = 0; c < channels; c++)
+				floatPtr[c * channelOffset] = value;
+			return;
+		}
+
+		// Separable resampling with the cached tables
+		float sums[4] = { 0.f, 0.f, 0.f, 0.f };
+		for (auto yTap = 0; yTap < yTaps; yTap++)
+		{
+			const auto yWeight = yWeights[y * yTaps + yTap];
+			const unsigned char* rowPtr = imgData + yIndexes[y * yTaps + yTap] * yStride;
+			for (auto xTap = 0; xTap < xTaps; xTap++)
+			{
+				const auto weight = yWeight * xWeights[x * xTaps + xTap];
+				const unsigned char* pixelPtr = rowPtr + xIndexes[x * xTaps + xTap] * xStride;
+				for (auto c = 0; c < channels; c++)
+					sums[c] += weight * pixelPtr[c];
+			}
+		}
+		// Same rounding than the uchar image, so the net input matches resizing first and converting after
+		for (auto c = 0; c < channels; c++)
+		{
+			const auto value = (unsigned char)min(max(__float2int_rn(sums[c]), 0), 255);
+			if (levelData != nullptr)
+				levelData[y * levelStep + x * channels + c] = value;
+			floatPtr[c * channelOffset] = (normalize ? value / 256.f - 0.5f : float(value));
+		}
+	}
+
 	void gpuMatToFloatPtr(float* floatImage, const unsigned char* imgData, const int channels, const Point<int>& sourceSize, const size_t step, const bool normalize, const unsigned long offset) {
 		dim3 threadsPerBlock;
 		dim3 numBlocks;
@@ -65,6 +114,30 @@ namespace op {
 		cudaCheck(__LINE__, __FUNCTION__, __FILE__);
 	}
 
+	void resizeGpuMatToFloatPtr(float* floatImage, unsigned char* levelData, const size_t levelStep, const unsigned char* imgData,
+		const int channels, const size_t xStride, const size_t yStride, const Point<int>& levelSize, const Point<int>& netSize,
+		const int* xIndexes, const float* xWeights, const int xTaps, const int* yIndexes, const float* yWeights, const int yTaps,
+		const bool normalize, const unsigned long offset)
+	{
+		try
+		{
+			// Security checks
+			if (channels > 4)
+				error("Only implemented for up to 4 channels.", __LINE__, __FUNCTION__, __FILE__);
+			dim3 threadsPerBlock;
+			dim3 numBlocks;
+			std::tie(threadsPerBlock, numBlocks) = getNumberCudaThreadsAndBlocks(netSize);
+			resizeToFloatKernel<<<numBlocks, threadsPerBlock>>>(floatImage + offset, levelData, levelStep, imgData, channels, xStride,
+			                                                    yStride, levelSize.x, levelSize.y, netSize.x, netSize.y, xIndexes, xWeights, xTaps,
+			                                                    yIndexes, yWeights, yTaps, normalize);
+			cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+		}
+		catch (const std::exception& e)
+		{
+			error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+		}
+	}
+
 	void floatPtrToGpuMat(unsigned char* imgData, const float* floatImage, const int channels, const Point<int>&sourceSize, const size_t step) {
 		dim3 threadsPerBlock;
 		dim3 numBlocks;
@@ -3,7 +3,9 @@
 
 namespace op
 {
-    Datum::Datum()
+    Datum::Datum() :
+        scaleProducerToInput{1.f},
+        inferenceSkipped{false}
     {
     }
 
@@ -15,6 +17,8 @@ namespace op
         // Input image and rendered version
         cvInputData{datum.cvInputData},
         inputNetData{datum.inputNetData},
+        inputPyramid{datum.inputPyramid},
+        inputPyramidScales{datum.inputPyramidScales},
         outputData{datum.outputData},
         cvOutputData{datum.cvOutputData},
         // Resulting Array<float> data
@@ -27,8 +31,12 @@ namespace op
         // Other parameters
         scaleInputToOutput{datum.scaleInputToOutput},
         scaleNetToOutput{datum.scaleNetToOutput},
+        scaleProducerToInput{datum.scaleProducerToInput},
         scaleRatios{datum.scaleRatios},
-        elementRendered{datum.elementRendered}
+        elementRendered{datum.elementRendered},
+        inferenceSkipped{datum.inferenceSkipped},
+        netInputSize{datum.netInputSize},
+        timestamp{datum.timestamp}
     {
     }
 
@@ -43,6 +51,8 @@ namespace op
             // Input image and rendered version
             cvInputData = datum.cvInputData;
             inputNetData = datum.inputNetData;
+            inputPyramid = datum.inputPyramid;
+            inputPyramidScales = datum.inputPyramidScales;
             outputData = datum.outputData;
             cvOutputData = datum.cvOutputData;
             // Resulting Array<float> data
@@ -55,8 +65,12 @@ namespace op
             // Other parameters
             scaleInputToOutput = datum.scaleInputToOutput;
             scaleNetToOutput = datum.scaleNetToOutput;
+            scaleProducerToInput = datum.scaleProducerToInput;
             scaleRatios = datum.scaleRatios;
             elementRendered = datum.elementRendered;
+            inferenceSkipped = datum.inferenceSkipped;
+            netInputSize = datum.netInputSize;
+            timestamp = datum.timestamp;
             // Return
             return *this;
         }
@@ -73,7 +87,11 @@ namespace op
         id{datum.id},
         // Other parameters
         scaleInputToOutput{datum.scaleInputToOutput},
-        scaleNetToOutput{datum.scaleNetToOutput}
+        scaleNetToOutput{datum.scaleNetToOutput},
+        scaleProducerToInput{datum.scaleProducerToInput},
+        inferenceSkipped{datum.inferenceSkipped},
+        netInputSize{datum.netInputSize},
+        timestamp{datum.timestamp}
     {
         try
         {
@@ -82,6 +100,8 @@ namespace op
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
             std::swap(inputNetData, datum.inputNetData);
+            std::swap(inputPyramid, datum.inputPyramid);
+            std::swap(inputPyramidScales, datum.inputPyramidScales);
             std::swap(outputData, datum.outputData);
             std::swap(cvOutputData, datum.cvOutputData);
             // Resulting Array<float> data
@@ -112,6 +132,8 @@ namespace op
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
             std::swap(inputNetData, datum.inputNetData);
+            std::swap(inputPyramid, datum.inputPyramid);
+            std::swap(inputPyramidScales, datum.inputPyramidScales);
             std::swap(outputData, datum.outputData);
             std::swap(cvOutputData, datum.cvOutputData);
             // Resulting Array<float> data
@@ -124,8 +146,12 @@ namespace op
             // Other parameters
             scaleInputToOutput = datum.scaleInputToOutput;
             scaleNetToOutput = datum.scaleNetToOutput;
+            scaleProducerToInput = datum.scaleProducerToInput;
             std::swap(scaleRatios, datum.scaleRatios);
             std::swap(elementRendered, datum.elementRendered);
+            inferenceSkipped = datum.inferenceSkipped;
+            netInputSize = datum.netInputSize;
+            timestamp = datum.timestamp;
             // Return
             return *this;
         }
@@ -152,6 +178,10 @@ namespace op
             // Input image and rendered version
             datum.cvInputData = cvInputData.clone();
             datum.inputNetData = inputNetData.clone();
+            datum.inputPyramid.resize(inputPyramid.size());
+            for (auto i = 0u ; i < inputPyramid.size() ; i++)
+                datum.inputPyramid[i] = inputPyramid[i].clone();
+            datum.inputPyramidScales = inputPyramidScales;
             datum.outputData = outputData.clone();
             datum.cvOutputData = cvOutputData.clone();
             // Resulting Array<float> data
@@ -165,8 +195,12 @@ namespace op
             // Other parameters
             datum.scaleInputToOutput = scaleInputToOutput;
             datum.scaleNetToOutput = scaleNetToOutput;
+            datum.scaleProducerToInput = scaleProducerToInput;
             datum.scaleRatios = scaleRatios;
             datum.elementRendered = elementRendered;
+            datum.inferenceSkipped = inferenceSkipped;
+            datum.netInputSize = netInputSize;
+            datum.timestamp = timestamp;
             // Return
             return std::move(datum);
         }
@@ -3,7 +3,9 @@
 namespace op
 {
     DEFINE_TEMPLATE_DATUM(WCvMatToOpInput);
+    DEFINE_TEMPLATE_DATUM(WCvMatToOpInputOutput);
     DEFINE_TEMPLATE_DATUM(WCvMatToOpOutput);
     DEFINE_TEMPLATE_DATUM(WKeypointScaler);
+    DEFINE_TEMPLATE_DATUM(WMotionGate);
     DEFINE_TEMPLATE_DATUM(WOpOutputToCvMat);
 }
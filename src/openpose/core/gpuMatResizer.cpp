@@ -0,0 +1,76 @@
+#include <vector>
+#include <openpose/utilities/cuda.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/core/gpuMatResizer.hpp>
+
+namespace op
+{
+    GpuMatResizer::GpuMatResizer() :
+        mSizes{{0,0,0,0,0,0}}
+    {
+    }
+
+    void GpuMatResizer::resize(float* floatImage, cv::cuda::GpuMat* target, const cv::cuda::GpuMat& source, const cv::Size& targetSize,
+                               const Point<int>& floatImageSize, const bool normalize, const unsigned long offset, const bool flip,
+                               const int rotation)
+    {
+        try
+        {
+            // Security checks
+            if (source.empty())
+                error("Empty source image.", __LINE__, __FUNCTION__, __FILE__);
+            if (targetSize.width > floatImageSize.x || targetSize.height > floatImageSize.y)
+                error("The target size cannot be bigger than the float image size.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Flip and rotation - The x (y) target axis runs along the source rows (columns) if transposed, backwards if mirrored
+            bool transpose, mirrorColumns, mirrorRows;
+            getFlipAndRotationAxes(transpose, mirrorColumns, mirrorRows, flip, rotation);
+            const std::array<int, 2> sourceSizes{{(transpose ? source.rows : source.cols), (transpose ? source.cols : source.rows)}};
+            const std::array<bool, 2> mirrors{{(transpose ? mirrorRows : mirrorColumns), (transpose ? mirrorColumns : mirrorRows)}};
+            const std::array<size_t, 2> strides{{(transpose ? source.step : source.elemSize()),
+                                                 (transpose ? source.elemSize() : source.step)}};
+
+            // Resampling tables (x and y) - Only recomputed if the resolutions or the orientation change
+            const std::array<int, 6> sizes{{sourceSizes[0], sourceSizes[1], targetSize.width, targetSize.height, (int)flip, rotation}};
+            if (mSizes != sizes)
+            {
+                mSizes = sizes;
+                std::vector<int> indexes;
+                std::vector<float> weights;
+                for (auto xy = 0 ; xy < 2 ; xy++)
+                {
+                    const auto taps = getResizeTable(indexes, weights, sizes[xy], sizes[2+xy]);
+                    // Mirrored axis - Source index i of the mirrored frame is N-1-i of the original one (same result than resizing
+                    // the mirrored frame)
+                    if (mirrors[xy])
+                        for (auto& index : indexes)
+                            index = sizes[xy] - 1 - index;
+                    mIndexes[xy].reset({sizes[2+xy], taps});
+                    mWeights[xy].reset({sizes[2+xy], taps});
+                    cudaMemcpy(mIndexes[xy].getPtr(), indexes.data(), indexes.size() * sizeof(int), cudaMemcpyHostToDevice);
+                    cudaMemcpy(mWeights[xy].getPtr(), weights.data(), weights.size() * sizeof(float), cudaMemcpyHostToDevice);
+                }
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+
+            // Fused resize + normalization + HWC to CHW (no-op create if same size)
+            unsigned char* targetData = nullptr;
+            size_t targetStep = 0;
+            if (target != nullptr)
+            {
+                target->create(targetSize, source.type());
+                targetData = target->data;
+                targetStep = target->step;
+            }
+            resizeGpuMatToFloatPtr(floatImage, targetData, targetStep, source.data, source.channels(), strides[0], strides[1],
+                                   Point<int>{targetSize.width, targetSize.height}, floatImageSize, mIndexes[0].getConstPtr(),
+                                   mWeights[0].getConstPtr(), mIndexes[0].getSize(1), mIndexes[1].getConstPtr(), mWeights[1].getConstPtr(),
+                                   mIndexes[1].getSize(1), normalize, offset);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
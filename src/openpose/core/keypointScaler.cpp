@@ -9,12 +9,13 @@ namespace op
     {
     }
 
-    void KeypointScaler::scale(Array<float>& arrayToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize) const
+    void KeypointScaler::scale(Array<float>& arrayToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize,
+                               const float scaleProducerToInput) const
     {
         try
         {
             std::vector<Array<float>> arrayToScalesToScale{arrayToScale};
-            scale(arrayToScalesToScale, scaleInputToOutput, scaleNetToOutput, producerSize);
+            scale(arrayToScalesToScale, scaleInputToOutput, scaleNetToOutput, producerSize, scaleProducerToInput);
         }
         catch (const std::exception& e)
         {
@@ -22,16 +23,17 @@ namespace op
         }
     }
 
-    void KeypointScaler::scale(std::vector<Array<float>>& arrayToScalesToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize) const
+    void KeypointScaler::scale(std::vector<Array<float>>& arrayToScalesToScale, const float scaleInputToOutput, const float scaleNetToOutput, const Point<int>& producerSize,
+                               const float scaleProducerToInput) const
     {
         try
         {
             if (mScaleMode != ScaleMode::OutputResolution)
             {
-                // InputResolution
+                // InputResolution (original producer frame, i.e. also undoing any reduced decoding)
                 if (mScaleMode == ScaleMode::InputResolution)
                     for (auto& arrayToScale : arrayToScalesToScale)
-                        scaleKeypoints(arrayToScale, 1.f/scaleInputToOutput);
+                        scaleKeypoints(arrayToScale, 1.f/(scaleInputToOutput*scaleProducerToInput));
                 // NetOutputResolution
                 else if (mScaleMode == ScaleMode::NetOutputResolution)
                     for (auto& arrayToScale : arrayToScalesToScale)
@@ -0,0 +1,99 @@
+#include <utility> // std::swap
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize, cv::cvtColor
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/motionGate.hpp>
+
+namespace op
+{
+    MotionGate::MotionGate(const float threshold, const int maxConsecutiveSkips, const int gateWidth) :
+        mThreshold{threshold},
+        mMaxConsecutiveSkips{maxConsecutiveSkips},
+        mGateWidth{gateWidth},
+        mConsecutiveSkips{0},
+        mSkippedFrames{0ull},
+        mProcessedFrames{0ull}
+    {
+        try
+        {
+            if (mThreshold < 0.f)
+                error("The motion gate threshold cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (mMaxConsecutiveSkips < 0)
+                error("The maximum number of consecutive skips cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (mGateWidth < 1)
+                error("The motion gate width must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MotionGate::skip(const cv::Mat& cvInputData)
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Small grayscale version of the frame (INTER_AREA also averages the sensor noise)
+            const auto gateWidth = fastMin(mGateWidth, cvInputData.cols);
+            const auto gateHeight = fastMax(1, intRound(gateWidth * cvInputData.rows / (float)cvInputData.cols));
+            cv::resize(cvInputData, mCurrentFrame, cv::Size{gateWidth, gateHeight}, 0, 0, cv::INTER_AREA);
+            if (mCurrentFrame.channels() == 3)
+                cv::cvtColor(mCurrentFrame, mCurrentGray, cv::COLOR_BGR2GRAY);
+            else
+                mCurrentFrame.copyTo(mCurrentGray);
+
+            // Compared against the last processed frame (not the last one), so slow drifts are also detected
+            if (!mReferenceFrame.empty() && mReferenceFrame.size() == mCurrentGray.size() && mConsecutiveSkips < mMaxConsecutiveSkips)
+            {
+                const auto meanDifference = cv::norm(mReferenceFrame, mCurrentGray, cv::NORM_L1) / (double)mCurrentGray.total();
+                if (meanDifference < mThreshold)
+                {
+                    mConsecutiveSkips++;
+                    mSkippedFrames++;
+                    return true;
+                }
+            }
+
+            // Frame to be processed -> new reference
+            std::swap(mReferenceFrame, mCurrentGray);
+            mConsecutiveSkips = 0;
+            mProcessedFrames++;
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    unsigned long long MotionGate::getSkippedFrames() const
+    {
+        try
+        {
+            return mSkippedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    unsigned long long MotionGate::getProcessedFrames() const
+    {
+        try
+        {
+            return mProcessedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #ifdef USE_CAFFE
+#include <algorithm> // std::copy
 #include <numeric> // std::accumulate
 #include <openpose/utilities/cuda.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
@@ -10,25 +11,64 @@
 
 namespace op
 {
-    NetCaffe::NetCaffe(const std::array<int, 4>& netInputSize4D, const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId, const std::string& lastBlobName) :
+    NetCaffe::NetCaffe(const std::array<int, 4>& netInputSize4D, const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId, const std::string& lastBlobName,
+                       const bool parallelScales) :
         mGpuId{gpuId},
         // mNetInputSize4D{netInputSize4D}, // This line crashes on some devices with old G++
         mNetInputSize4D{netInputSize4D[0], netInputSize4D[1], netInputSize4D[2], netInputSize4D[3]},
         mNetInputMemory{std::accumulate(mNetInputSize4D.begin(), mNetInputSize4D.end(), 1, std::multiplies<int>()) * sizeof(float)},
         mCaffeProto{caffeProto},
         mCaffeTrainedModel{caffeTrainedModel},
-        mLastBlobName{lastBlobName}
+        mLastBlobName{lastBlobName},
+        mParallelScales{parallelScales},
+        mScaleJob{0},
+        mScalesPending{0},
+        mScaleThreadsStop{false}
     {
     }
 
     NetCaffe::~NetCaffe()
     {
+        stopScaleThreads();
     }
 
     void NetCaffe::initializationOnThread()
     {
         try
         {
+            // (Re)initialization - The scale threads use the previous nets
+            stopScaleThreads();
+            upScaleNets.clear();
+            upInputBlob.reset();
+            // Parallel scales - 1 CPU net per scale, all sharing the weights of the first one
+            if (parallelScales())
+            {
+#ifndef CPU_ONLY
+                // The post-processing still runs on this GPU
+                caffe::Caffe::SetDevice(mGpuId);
+#endif
+                // Caffe mode is thread-specific, and other nets (e.g. face and hand) might run on this thread in GPU mode
+                const auto previousMode = caffe::Caffe::mode();
+                caffe::Caffe::set_mode(caffe::Caffe::CPU);
+                upCaffeNet.reset(new caffe::Net<float>{mCaffeProto, caffe::TEST});
+                upCaffeNet->CopyTrainedLayersFrom(mCaffeTrainedModel);
+                for (auto scale = 1 ; scale < mNetInputSize4D[0] ; scale++)
+                {
+                    upScaleNets.emplace_back(new caffe::Net<float>{mCaffeProto, caffe::TEST});
+                    upScaleNets.back()->ShareTrainedLayersWith(upCaffeNet.get());
+                }
+                upInputBlob.reset(new caffe::Blob<float>{});
+                spOutputBlob.reset(new caffe::Blob<float>{});
+                reshapeParallelScales();
+                caffe::Caffe::set_mode(previousMode);
+                // 1 thread per extra scale, the first one runs on the calling thread (no pending job for the new threads)
+                mScaleThreadsStop = false;
+                mScaleJob = 0;
+                mScalesPending = 0;
+                for (auto scaleNet = 0u ; scaleNet < upScaleNets.size() ; scaleNet++)
+                    mScaleThreads.emplace_back(&NetCaffe::scaleThreadLoop, this, scaleNet);
+                return;
+            }
             // Initialize net
             caffe::Caffe::set_mode(caffe::Caffe::GPU);
             caffe::Caffe::SetDevice(mGpuId);
@@ -49,10 +89,43 @@ namespace op
         }
     }
 
+    void NetCaffe::reshape(const std::array<int, 4>& netInputSize4D)
+    {
+        try
+        {
+            if (netInputSize4D != mNetInputSize4D)
+            {
+                const auto numberScalesChanged = (netInputSize4D[0] != mNetInputSize4D[0]);
+                mNetInputSize4D = netInputSize4D;
+                mNetInputMemory = std::accumulate(mNetInputSize4D.begin(), mNetInputSize4D.end(), 1, std::multiplies<int>()) * sizeof(float);
+                // Parallel scales - 1 net and 1 thread per scale (or a single GPU net with 1 scale), so they must be rebuilt
+                if (mParallelScales && numberScalesChanged)
+                {
+                    initializationOnThread();
+                    return;
+                }
+                if (parallelScales())
+                {
+                    reshapeParallelScales();
+                    return;
+                }
+                upCaffeNet->blobs()[0]->Reshape({mNetInputSize4D[0], mNetInputSize4D[1], mNetInputSize4D[2], mNetInputSize4D[3]});
+                upCaffeNet->Reshape();
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     float* NetCaffe::getInputDataCpuPtr() const
     {
         try
         {
+            if (parallelScales())
+                return upInputBlob->mutable_cpu_data();
             return upCaffeNet->blobs().at(0)->mutable_cpu_data();
         }
         catch (const std::exception& e)
@@ -66,6 +139,8 @@ namespace op
     {
         try
         {
+            if (parallelScales())
+                return upInputBlob->mutable_gpu_data();
             return upCaffeNet->blobs().at(0)->mutable_gpu_data();
         }
         catch (const std::exception& e)
@@ -79,6 +154,13 @@ namespace op
     {
         try
         {
+            if (parallelScales())
+            {
+                if (inputData != nullptr)
+                    std::copy(inputData, inputData + upInputBlob->count(), upInputBlob->mutable_cpu_data());
+                forwardPassParallelScales();
+                return;
+            }
             // Copy frame data to GPU memory
             if (inputData != nullptr)
             {
@@ -107,6 +189,132 @@ namespace op
             return nullptr;
         }
     }
+
+    bool NetCaffe::parallelScales() const
+    {
+        return mParallelScales && mNetInputSize4D[0] > 1;
+    }
+
+    void NetCaffe::reshapeParallelScales()
+    {
+        try
+        {
+            // Each net processes 1 scale
+            const std::vector<int> scaleShape{1, mNetInputSize4D[1], mNetInputSize4D[2], mNetInputSize4D[3]};
+            upCaffeNet->blobs()[0]->Reshape(scaleShape);
+            upCaffeNet->Reshape();
+            for (auto& scaleNet : upScaleNets)
+            {
+                scaleNet->blobs()[0]->Reshape(scaleShape);
+                scaleNet->Reshape();
+            }
+            // Shared input and output blobs with all the scales
+            upInputBlob->Reshape({mNetInputSize4D[0], mNetInputSize4D[1], mNetInputSize4D[2], mNetInputSize4D[3]});
+            const auto scaleOutputBlob = upCaffeNet->blob_by_name(mLastBlobName);
+            if (scaleOutputBlob == nullptr)
+                error("The output blob is a nullptr. Did you use the same name than the prototxt? (Used: " + mLastBlobName + ").", __LINE__, __FUNCTION__, __FILE__);
+            auto outputShape = scaleOutputBlob->shape();
+            outputShape[0] = mNetInputSize4D[0];
+            spOutputBlob->Reshape(outputShape);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetCaffe::forwardPassParallelScales() const
+    {
+        try
+        {
+            // Each net reads its scale directly from the shared input blob
+            auto* inputPtr = upInputBlob->mutable_cpu_data();
+            const auto inputVolume = upInputBlob->count(1);
+            upCaffeNet->blobs()[0]->set_cpu_data(inputPtr);
+            for (auto scaleNet = 0u ; scaleNet < upScaleNets.size() ; scaleNet++)
+                upScaleNets[scaleNet]->blobs()[0]->set_cpu_data(inputPtr + (scaleNet+1) * inputVolume);
+            // Run the extra scales on their threads and the first one on this one
+            {
+                std::lock_guard<std::mutex> lock{mScaleMutex};
+                mScalesPending = (int)upScaleNets.size();
+                mScaleJob++;
+            }
+            mScaleConditionVariable.notify_all();
+            // Caffe mode is thread-specific, and other nets (e.g. face and hand) might run on this thread in GPU mode
+            const auto previousMode = caffe::Caffe::mode();
+            caffe::Caffe::set_mode(caffe::Caffe::CPU);
+            upCaffeNet->ForwardFrom(0);
+            caffe::Caffe::set_mode(previousMode);
+            {
+                std::unique_lock<std::mutex> lock{mScaleMutex};
+                mScaleConditionVariable.wait(lock, [this]{ return mScalesPending == 0; });
+            }
+            // Concatenate outputs
+            auto* outputPtr = spOutputBlob->mutable_cpu_data();
+            const auto outputVolume = spOutputBlob->count(1);
+            const auto* scaleOutputPtr = upCaffeNet->blob_by_name(mLastBlobName)->cpu_data();
+            std::copy(scaleOutputPtr, scaleOutputPtr + outputVolume, outputPtr);
+            for (auto scaleNet = 0u ; scaleNet < upScaleNets.size() ; scaleNet++)
+            {
+                scaleOutputPtr = upScaleNets[scaleNet]->blob_by_name(mLastBlobName)->cpu_data();
+                std::copy(scaleOutputPtr, scaleOutputPtr + outputVolume, outputPtr + (scaleNet+1) * outputVolume);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetCaffe::scaleThreadLoop(const int scaleNet)
+    {
+        try
+        {
+            // Caffe mode is thread-specific
+            caffe::Caffe::set_mode(caffe::Caffe::CPU);
+            auto lastJob = 0ull;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mScaleMutex};
+                    mScaleConditionVariable.wait(lock, [&]{ return mScaleThreadsStop || mScaleJob != lastJob; });
+                    if (mScaleThreadsStop)
+                        return;
+                    lastJob = mScaleJob;
+                }
+                upScaleNets[scaleNet]->ForwardFrom(0);
+                {
+                    std::lock_guard<std::mutex> lock{mScaleMutex};
+                    mScalesPending--;
+                }
+                mScaleConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetCaffe::stopScaleThreads()
+    {
+        try
+        {
+            {
+                std::lock_guard<std::mutex> lock{mScaleMutex};
+                mScaleThreadsStop = true;
+            }
+            mScaleConditionVariable.notify_all();
+            for (auto& scaleThread : mScaleThreads)
+                if (scaleThread.joinable())
+                    scaleThread.join();
+            mScaleThreads.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
 
 #endif
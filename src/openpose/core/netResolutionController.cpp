@@ -0,0 +1,116 @@
+#include <algorithm> // std::find_if
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/core/netResolutionController.hpp>
+
+namespace op
+{
+    NetResolutionController::NetResolutionController(const std::vector<Point<int>>& netInputSizes, const Point<int>& initialNetInputSize,
+                                                     const double latencyBudgetMs, const bool dynamicNetInputWidth,
+                                                     const double hysteresis, const int framesPerStep) :
+        mNetInputSizes{netInputSizes},
+        mLatencyBudgetMs{latencyBudgetMs},
+        mDynamicNetInputWidth{dynamicNetInputWidth},
+        mHysteresis{hysteresis},
+        mFramesPerStep{framesPerStep},
+        mNetInputSizeIndex{0},
+        mAccumulatedLatencyMs{0.},
+        mAccumulatedFrames{0}
+    {
+        try
+        {
+            // Security checks
+            if (mNetInputSizes.empty())
+                error("At least 1 net input resolution is required.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 0u ; i < mNetInputSizes.size() ; i++)
+            {
+                if (mNetInputSizes[i].x % 16 != 0 || mNetInputSizes[i].y % 16 != 0)
+                    error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+                if (i > 0 && mNetInputSizes[i].area() >= mNetInputSizes[i-1].area())
+                    error("The net input resolutions must be sorted from the highest to the lowest one.", __LINE__, __FUNCTION__, __FILE__);
+                // Dynamic net input width - Only the height identifies the resolution
+                if (mDynamicNetInputWidth && i > 0 && mNetInputSizes[i].y == mNetInputSizes[i-1].y)
+                    error("With the dynamic net input width, the net input resolutions must have different heights.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (mLatencyBudgetMs <= 0.)
+                error("The latency budget must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (mHysteresis < 0. || mHysteresis >= 1.)
+                error("The hysteresis must be in the range [0, 1).", __LINE__, __FUNCTION__, __FILE__);
+            if (mFramesPerStep < 1)
+                error("The number of frames per step must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            // Initial resolution
+            // Point::operator== only compares the areas
+            const auto initialIterator = std::find_if(mNetInputSizes.begin(), mNetInputSizes.end(),
+                                                      [&](const Point<int>& netInputSize)
+                                                      {
+                                                          return netInputSize.x == initialNetInputSize.x
+                                                              && netInputSize.y == initialNetInputSize.y;
+                                                      });
+            if (initialIterator == mNetInputSizes.end())
+                error("The initial net input resolution must be one of the available ones.", __LINE__, __FUNCTION__, __FILE__);
+            mNetInputSizeIndex = (int)(initialIterator - mNetInputSizes.begin());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Point<int> NetResolutionController::getNetInputSize() const
+    {
+        try
+        {
+            return mNetInputSizes[mNetInputSizeIndex];
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    void NetResolutionController::report(const double latencyMs, const Point<int>& netInputSize)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mReportMutex};
+            // Frame queued before the last resolution change - Not representative of the current resolution
+            const auto& currentNetInputSize = mNetInputSizes[mNetInputSizeIndex];
+            if (netInputSize.y != currentNetInputSize.y || (!mDynamicNetInputWidth && netInputSize.x != currentNetInputSize.x))
+                return;
+            mAccumulatedLatencyMs += latencyMs;
+            mAccumulatedFrames++;
+            if (mAccumulatedFrames >= mFramesPerStep)
+            {
+                const auto averageLatencyMs = mAccumulatedLatencyMs / mAccumulatedFrames;
+                const int index = mNetInputSizeIndex;
+                auto newIndex = index;
+                // Over budget -> Lower resolution
+                if (averageLatencyMs > mLatencyBudgetMs && index + 1 < (int)mNetInputSizes.size())
+                    newIndex = index + 1;
+                // Enough margin for the higher resolution -> Higher resolution
+                else if (index > 0)
+                {
+                    const auto predictedLatencyMs = averageLatencyMs * mNetInputSizes[index-1].area() / (double)mNetInputSizes[index].area();
+                    if (predictedLatencyMs < (1. - mHysteresis) * mLatencyBudgetMs)
+                        newIndex = index - 1;
+                }
+                if (newIndex != index)
+                {
+                    mNetInputSizeIndex = newIndex;
+                    const auto& netInputSize = mNetInputSizes[newIndex];
+                    log("Average latency of " + std::to_string(averageLatencyMs) + " ms (budget: " + std::to_string(mLatencyBudgetMs)
+                        + " ms). Net input resolution changed to " + std::to_string(netInputSize.x) + "x" + std::to_string(netInputSize.y)
+                        + ".", Priority::Normal, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Next measurement window (only frames formatted with the new resolution if it changed)
+                mAccumulatedLatencyMs = 0.;
+                mAccumulatedFrames = 0;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
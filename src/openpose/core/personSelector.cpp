@@ -0,0 +1,103 @@
+#include <algorithm> // std::partial_sort
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/core/personSelector.hpp>
+
+namespace op
+{
+    // Threshold to compute the people rectangles (same one than the face and hand detectors)
+    const auto PERSON_SELECTOR_THRESHOLD = 0.25f;
+
+    PersonSelector::PersonSelector(const int maxPeople, const PersonPriority personPriority, const Point<float>& pointOfInterest,
+                                   const PriorityFunction& priorityFunction) :
+        mMaxPeople{maxPeople},
+        mPersonPriority{personPriority},
+        mPointOfInterest{pointOfInterest},
+        mPriorityFunction{priorityFunction}
+    {
+        try
+        {
+            if (mMaxPeople < 0)
+                error("The maximum number of people cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (mPersonPriority == PersonPriority::Callback && !mPriorityFunction)
+                error("PersonPriority::Callback requires a priority function.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<bool> PersonSelector::select(const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            // Everybody fits in the budget
+            if (numberPeople <= mMaxPeople)
+                return std::vector<bool>(numberPeople, true);
+            // Priority of each person
+            const auto numberKeypoints = poseKeypoints.getSize(1);
+            const auto personVolume = numberKeypoints * poseKeypoints.getSize(2);
+            std::vector<std::pair<float, int>> priorities(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto* personPtr = &poseKeypoints[person * personVolume];
+                float priority;
+                if (mPersonPriority == PersonPriority::Area)
+                    priority = getKeypointsArea(personPtr, numberKeypoints, PERSON_SELECTOR_THRESHOLD);
+                else if (mPersonPriority == PersonPriority::Distance)
+                {
+                    const auto rectangle = getKeypointsRectangle(personPtr, numberKeypoints, PERSON_SELECTOR_THRESHOLD);
+                    const auto center = rectangle.center();
+                    const auto dx = center.x - mPointOfInterest.x;
+                    const auto dy = center.y - mPointOfInterest.y;
+                    // People without visible keypoints go last
+                    priority = (rectangle.area() > 0 ? -(dx*dx + dy*dy) : std::numeric_limits<float>::lowest());
+                }
+                else if (mPersonPriority == PersonPriority::Callback)
+                    priority = mPriorityFunction(poseKeypoints, person);
+                else
+                {
+                    error("Unknown PersonPriority.", __LINE__, __FUNCTION__, __FILE__);
+                    priority = 0.f;
+                }
+                // Ties -> lowest index first
+                priorities[person] = std::make_pair(-priority, person);
+            }
+            // Top mMaxPeople
+            std::partial_sort(priorities.begin(), priorities.begin() + mMaxPeople, priorities.end());
+            std::vector<bool> selectedPeople(numberPeople, false);
+            for (auto i = 0 ; i < mMaxPeople ; i++)
+                selectedPeople[priorities[i].second] = true;
+            return selectedPeople;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::vector<bool>{};
+        }
+    }
+
+    void PersonSelector::markNotEvaluated(Array<float>& keypoints, const std::vector<bool>& selectedPeople) const
+    {
+        try
+        {
+            if (!keypoints.empty())
+            {
+                const auto numberPeople = fastMin(keypoints.getSize(0), (int)selectedPeople.size());
+                const auto personVolume = keypoints.getSize(1) * keypoints.getSize(2);
+                for (auto person = 0 ; person < numberPeople ; person++)
+                    if (!selectedPeople[person])
+                        for (auto part = 2 ; part < personVolume ; part+=3)
+                            keypoints[person * personVolume + part] = KEYPOINT_NOT_EVALUATED_SCORE;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,3 +1,6 @@
+#include <algorithm> // std::copy, std::max, std::min
+#include <thrust/device_ptr.h>
+#include <thrust/extrema.h>
 #include <openpose/utilities/cuda.hpp>
 #include <openpose/utilities/cuda.hu>
 #include <openpose/utilities/errorAndLog.hpp>
@@ -6,6 +9,19 @@
 namespace op
 {
     const auto THREADS_PER_BLOCK_1D = 16u;
+    // Side (in source pixels) of the tiles of resizeAndMergeSparseGpu
+    const auto SPARSE_TILE_SIZE = 4;
+    // Source pixels around a tile that contribute to its bicubic interpolation
+    const auto SPARSE_TILE_HALO = 2;
+    // Maximum distance (in target pixels) between a peak and the pixels read by NMS (i.e. its 7x7 sub-pixel refinement window)
+    const auto SPARSE_NMS_RADIUS = 3;
+
+    // Maximum value of a bicubic (Catmull-Rom) interpolation of values in [minValue, maxValue] (see resizeAndMergeMaxBoundGpu)
+    template <typename T>
+    inline __host__ __device__ T getBicubicMaxBound(const T minValue, const T maxValue)
+    {
+        return T(1.4453125) * maxValue - T(0.4453125) * minValue;
+    }
 
     template <typename T>
     __global__ void resizeKernel(T* targetPtr, const T* const sourcePtr, const int sourceWidth, const int sourceHeight, const int targetWidth,
@@ -25,6 +41,72 @@ namespace op
         }
     }
 
+    template <typename T>
+    __global__ void tileMaskKernel(unsigned char* tileMaskPtr, const T* const sourcePtr, const int sourceWidth, const int sourceHeight,
+                                   const int tilesX, const int tilesY, const T threshold)
+    {
+        const auto tileX = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto tileY = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto channel = blockIdx.z;
+
+        if (tileX < tilesX && tileY < tilesY)
+        {
+            const auto* const sourcePtrC = sourcePtr + channel * sourceWidth * sourceHeight;
+            const auto xMin = fastMax(0, int(tileX * SPARSE_TILE_SIZE) - SPARSE_TILE_HALO);
+            const auto xMax = fastMin(sourceWidth - 1, int((tileX+1) * SPARSE_TILE_SIZE) - 1 + SPARSE_TILE_HALO);
+            const auto yMin = fastMax(0, int(tileY * SPARSE_TILE_SIZE) - SPARSE_TILE_HALO);
+            const auto yMax = fastMin(sourceHeight - 1, int((tileY+1) * SPARSE_TILE_SIZE) - 1 + SPARSE_TILE_HALO);
+            T minValue = 0;
+            T maxValue = 0;
+            for (auto y = yMin ; y <= yMax ; y++)
+            {
+                for (auto x = xMin ; x <= xMax ; x++)
+                {
+                    const auto value = sourcePtrC[y*sourceWidth + x];
+                    minValue = fastMin(minValue, value);
+                    maxValue = fastMax(maxValue, value);
+                }
+            }
+            tileMaskPtr[(channel * tilesY + tileY) * tilesX + tileX] = (getBicubicMaxBound(minValue, maxValue) > threshold);
+        }
+    }
+
+    template <typename T>
+    __global__ void resizeSparseKernel(T* targetPtr, const T* const sourcePtr, const unsigned char* const tileMaskPtr, const int sourceWidth,
+                                       const int sourceHeight, const int targetWidth, const int targetHeight, const int tilesX,
+                                       const int tilesY)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+        if (x < targetWidth && y < targetHeight)
+        {
+            const auto scaleWidth = targetWidth / T(sourceWidth);
+            const auto scaleHeight = targetHeight / T(sourceHeight);
+            const T xSource = (x + 0.5f) / scaleWidth - 0.5f;
+            const T ySource = (y + 0.5f) / scaleHeight - 0.5f;
+
+            // Same tile than the one of cubicSequentialData. The neighbor tiles act as halo, so every pixel read by NMS around a peak
+            // is interpolated
+            const auto tileX = fastTruncate(int(xSource + 1e-5), 0, sourceWidth - 1) / SPARSE_TILE_SIZE;
+            const auto tileY = fastTruncate(int(ySource + 1e-5), 0, sourceHeight - 1) / SPARSE_TILE_SIZE;
+            auto hot = false;
+            for (auto dy = -1 ; dy < 2 && !hot ; dy++)
+            {
+                const auto neighborY = tileY + dy;
+                if (0 <= neighborY && neighborY < tilesY)
+                    for (auto dx = -1 ; dx < 2 && !hot ; dx++)
+                    {
+                        const auto neighborX = tileX + dx;
+                        hot = (0 <= neighborX && neighborX < tilesX && tileMaskPtr[neighborY * tilesX + neighborX]);
+                    }
+            }
+
+            targetPtr[y*targetWidth+x] = (hot ? bicubicInterpolate(sourcePtr, xSource, ySource, sourceWidth, sourceHeight, sourceWidth)
+                                              : T(0));
+        }
+    }
+
     template <typename T>
     __global__ void resizeKernelAndMerge(T* targetPtr, const T* const sourcePtr, const int sourceNumOffset, const int num, const T* scaleRatios,
                                          const int sourceWidth, const int sourceHeight, const int targetWidth, const int targetHeight)
@@ -57,6 +139,49 @@ namespace op
         }
     }
 
+    template <typename T>
+    __global__ void resizeKernelAndMergeTiles(T* targetPtr, const T* const sourcePtr, const T* const tileOffsets, const T* const scaleRatios,
+                                              const int numberTiles, const int numberScales, const T tileWidth, const T tileHeight,
+                                              const T factor, const int channels, const int sourceWidth, const int sourceHeight,
+                                              const int targetWidth, const int targetHeight)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto channel = blockIdx.z;
+
+        if (x < targetWidth && y < targetHeight)
+        {
+            const auto sourceChannelOffset = sourceWidth * sourceHeight;
+            T weightedSum = 0;
+            T weightSum = 0;
+            for (auto tile = 0 ; tile < numberTiles ; tile++)
+            {
+                // Pixel center in tile coordinates. Its weight is the distance to the closest tile border (+1, so the tile border still
+                // counts if no other tile covers it)
+                const T xTile = x + 0.5f - tileOffsets[2*tile];
+                const T yTile = y + 0.5f - tileOffsets[2*tile+1];
+                const auto weight = fastMin(fastMin(xTile, tileWidth - xTile), fastMin(yTile, tileHeight - yTile)) + T(1);
+                if (weight > 0)
+                {
+                    // Scales of the tile averaged (as in resizeKernelAndMerge)
+                    T interpolated = 0;
+                    for (auto scale = 0 ; scale < numberScales ; scale++)
+                    {
+                        const auto scaleRatio = scaleRatios[scale];
+                        const T xSource = xTile * scaleRatio / factor - 0.5f;
+                        const T ySource = yTile * scaleRatio / factor - 0.5f;
+                        const T* const sourcePtrN = sourcePtr + ((tile * numberScales + scale) * channels + channel) * sourceChannelOffset;
+                        interpolated += bicubicInterpolate(sourcePtrN, xSource, ySource, intRound(sourceWidth * scaleRatio),
+                                                           intRound(sourceHeight * scaleRatio), sourceWidth);
+                    }
+                    weightedSum += weight * interpolated / numberScales;
+                    weightSum += weight;
+                }
+            }
+            targetPtr[(channel * targetHeight + y) * targetWidth + x] = (weightSum > 0 ? weightedSum / weightSum : T(0));
+        }
+    }
+
     template <typename T>
     void resizeAndMergeGpu(T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
                            const std::array<int, 4>& sourceSize, const std::vector<T>& scaleRatios)
@@ -121,8 +246,177 @@ namespace op
         }
     }
 
+    template <typename T>
+    void resizeAndMergeTilesGpu(T* targetPtr, T* tileParametersPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+                                const std::array<int, 4>& sourceSize, const std::vector<std::array<T, 2>>& tileOffsets,
+                                const std::array<T, 2>& tileSize, const T factor, const std::vector<T>& scaleRatios)
+    {
+        try
+        {
+            const auto numberTiles = (int)tileOffsets.size();
+            const auto numberScales = (int)scaleRatios.size();
+            const auto channels = sourceSize[1];
+            const auto sourceHeight = sourceSize[2];
+            const auto sourceWidth = sourceSize[3];
+            const auto targetHeight = targetSize[2];
+            const auto targetWidth = targetSize[3];
+            // Security checks
+            if (numberTiles == 0 || numberScales == 0)
+                error("At least 1 tile and 1 scale are required.", __LINE__, __FUNCTION__, __FILE__);
+            if (sourceSize[0] != numberTiles * numberScales || targetSize[0] != 1)
+                error("The source must contain every scale of every tile, and the target a single frame.", __LINE__, __FUNCTION__, __FILE__);
+            if (tileParametersPtr == nullptr)
+                error("The tile parameters buffer cannot be nullptr.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Tile offsets and scale ratios
+            std::vector<T> tileParameters(2 * numberTiles + numberScales);
+            for (auto tile = 0 ; tile < numberTiles ; tile++)
+            {
+                tileParameters[2*tile] = tileOffsets[tile][0];
+                tileParameters[2*tile+1] = tileOffsets[tile][1];
+            }
+            std::copy(scaleRatios.begin(), scaleRatios.end(), tileParameters.begin() + 2 * numberTiles);
+            cudaMemcpy(tileParametersPtr, tileParameters.data(), tileParameters.size() * sizeof(T), cudaMemcpyHostToDevice);
+
+            // Resize + merge of all the channels
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x), getNumberCudaBlocks(targetHeight, threadsPerBlock.y),
+                                 (unsigned int)channels};
+            resizeKernelAndMergeTiles<<<numBlocks, threadsPerBlock>>>(targetPtr, sourcePtr, tileParametersPtr,
+                                                                      tileParametersPtr + 2 * numberTiles, numberTiles, numberScales,
+                                                                      tileSize[0], tileSize[1], factor, channels, sourceWidth,
+                                                                      sourceHeight, targetWidth, targetHeight);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int getResizeAndMergeSparseMaskSize(const std::array<int, 4>& sourceSize, const int numberSparseChannels)
+    {
+        try
+        {
+            const auto tilesX = (sourceSize[3] + SPARSE_TILE_SIZE - 1) / SPARSE_TILE_SIZE;
+            const auto tilesY = (sourceSize[2] + SPARSE_TILE_SIZE - 1) / SPARSE_TILE_SIZE;
+            return numberSparseChannels * tilesX * tilesY;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template <typename T>
+    void resizeAndMergeSparseGpu(T* targetPtr, unsigned char* tileMaskPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
+                                 const std::array<int, 4>& sourceSize, const int numberSparseChannels, const T threshold)
+    {
+        try
+        {
+            const auto channels = sourceSize[1];
+            const auto sourceHeight = sourceSize[2];
+            const auto sourceWidth = sourceSize[3];
+            const auto targetHeight = targetSize[2];
+            const auto targetWidth = targetSize[3];
+            // Security checks
+            if (sourceSize[0] != 1 || targetSize[0] != 1)
+                error("The sparse resize only supports 1 scale.", __LINE__, __FUNCTION__, __FILE__);
+            if (numberSparseChannels > channels)
+                error("More sparse channels than channels.", __LINE__, __FUNCTION__, __FILE__);
+            if (numberSparseChannels > 0 && tileMaskPtr == nullptr)
+                error("The tile mask buffer cannot be nullptr.", __LINE__, __FUNCTION__, __FILE__);
+            // The neighbor tiles must cover the NMS window, otherwise the halo is not enough
+            if (SPARSE_TILE_SIZE * std::min(targetWidth / (float)sourceWidth, targetHeight / (float)sourceHeight) < SPARSE_NMS_RADIUS + 1)
+            {
+                resizeAndMergeGpu(targetPtr, sourcePtr, targetSize, sourceSize);
+                return;
+            }
+
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x), getNumberCudaBlocks(targetHeight, threadsPerBlock.y)};
+            const auto sourceChannelOffset = sourceHeight * sourceWidth;
+            const auto targetChannelOffset = targetWidth * targetHeight;
+
+            // Hot tiles of the sparse channels
+            const auto tilesX = (sourceWidth + SPARSE_TILE_SIZE - 1) / SPARSE_TILE_SIZE;
+            const auto tilesY = (sourceHeight + SPARSE_TILE_SIZE - 1) / SPARSE_TILE_SIZE;
+            const auto tilesPerChannel = tilesX * tilesY;
+            if (numberSparseChannels > 0)
+            {
+                const dim3 numTileBlocks{getNumberCudaBlocks(tilesX, threadsPerBlock.x), getNumberCudaBlocks(tilesY, threadsPerBlock.y),
+                                         (unsigned int)numberSparseChannels};
+                tileMaskKernel<<<numTileBlocks, threadsPerBlock>>>(tileMaskPtr, sourcePtr, sourceWidth, sourceHeight, tilesX, tilesY,
+                                                                   threshold);
+            }
+            // Resize
+            for (auto c = 0 ; c < channels ; c++)
+            {
+                if (c < numberSparseChannels)
+                    resizeSparseKernel<<<numBlocks, threadsPerBlock>>>(targetPtr + c * targetChannelOffset,
+                                                                       sourcePtr + c * sourceChannelOffset,
+                                                                       tileMaskPtr + c * tilesPerChannel, sourceWidth,
+                                                                       sourceHeight, targetWidth, targetHeight, tilesX, tilesY);
+                else
+                    resizeKernel<<<numBlocks, threadsPerBlock>>>(targetPtr + c * targetChannelOffset, sourcePtr + c * sourceChannelOffset,
+                                                                 sourceWidth, sourceHeight, targetWidth, targetHeight);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    T resizeAndMergeMaxBoundGpu(const T* const sourcePtr, const std::array<int, 4>& sourceSize, const int numberChannels)
+    {
+        try
+        {
+            const auto num = sourceSize[0];
+            const auto sourceChannelOffset = sourceSize[2] * sourceSize[3];
+            const auto sourceNumOffset = sourceSize[1] * sourceChannelOffset;
+            // Min and max of the selected channels of each scale
+            auto maxValue = T(0);
+            auto minValue = T(0);
+            for (auto n = 0 ; n < num ; n++)
+            {
+                const auto sourceThrustPtr = thrust::device_pointer_cast(sourcePtr + n * sourceNumOffset);
+                const auto minMax = thrust::minmax_element(sourceThrustPtr, sourceThrustPtr + numberChannels * sourceChannelOffset);
+                minValue = std::min(minValue, T(*minMax.first));
+                maxValue = std::max(maxValue, T(*minMax.second));
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            // Bicubic overshoot
+            return getBicubicMaxBound(minValue, maxValue);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return T(0);
+        }
+    }
+
     template void resizeAndMergeGpu(float* targetPtr, const float* const sourcePtr, const std::array<int, 4>& targetSize,
                                     const std::array<int, 4>& sourceSize, const std::vector<float>& scaleRatios);
     template void resizeAndMergeGpu(double* targetPtr, const double* const sourcePtr, const std::array<int, 4>& targetSize,
                                     const std::array<int, 4>& sourceSize, const std::vector<double>& scaleRatios);
+    template void resizeAndMergeTilesGpu(float* targetPtr, float* tileParametersPtr, const float* const sourcePtr,
+                                         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                         const std::vector<std::array<float, 2>>& tileOffsets, const std::array<float, 2>& tileSize,
+                                         const float factor, const std::vector<float>& scaleRatios);
+    template void resizeAndMergeTilesGpu(double* targetPtr, double* tileParametersPtr, const double* const sourcePtr,
+                                         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                         const std::vector<std::array<double, 2>>& tileOffsets, const std::array<double, 2>& tileSize,
+                                         const double factor, const std::vector<double>& scaleRatios);
+    template float resizeAndMergeMaxBoundGpu(const float* const sourcePtr, const std::array<int, 4>& sourceSize, const int numberChannels);
+    template double resizeAndMergeMaxBoundGpu(const double* const sourcePtr, const std::array<int, 4>& sourceSize, const int numberChannels);
+    template void resizeAndMergeSparseGpu(float* targetPtr, unsigned char* tileMaskPtr, const float* const sourcePtr,
+                                          const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                          const int numberSparseChannels, const float threshold);
+    template void resizeAndMergeSparseGpu(double* targetPtr, unsigned char* tileMaskPtr, const double* const sourcePtr,
+                                          const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize,
+                                          const int numberSparseChannels, const double threshold);
 }
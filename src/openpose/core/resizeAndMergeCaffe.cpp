@@ -9,7 +9,10 @@ namespace op
 {
     template <typename T>
     ResizeAndMergeCaffe<T>::ResizeAndMergeCaffe() :
-        mScaleRatios{1}
+        mScaleRatios{1},
+        mNumberSparseChannels{0},
+        mSparseThreshold{0},
+        mTileFactor{1}
     {
     }
 
@@ -55,6 +58,28 @@ namespace op
         }
     }
 
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::ReshapeTiles(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top,
+                                              const int topWidth, const int topHeight)
+    {
+        try
+        {
+            auto bottomBlob = bottom.at(0);
+            auto topBlob = top.at(0);
+
+            // Top shape
+            topBlob->Reshape({1, bottomBlob->shape(1), topHeight, topWidth});
+
+            // Array sizes
+            mTopSize = std::array<int, 4>{topBlob->shape(0), topBlob->shape(1), topBlob->shape(2), topBlob->shape(3)};
+            mBottomSize = std::array<int, 4>{bottomBlob->shape(0), bottomBlob->shape(1), bottomBlob->shape(2), bottomBlob->shape(3)};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void ResizeAndMergeCaffe<T>::setScaleRatios(const std::vector<T>& scaleRatios)
     {
@@ -68,11 +93,43 @@ namespace op
         }
     }
 
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setTiles(const std::vector<std::array<T, 2>>& tileOffsets, const std::array<T, 2>& tileSize,
+                                          const T factor)
+    {
+        try
+        {
+            mTileOffsets = {tileOffsets};
+            mTileSize = {tileSize};
+            mTileFactor = {factor};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::setSparse(const int numberSparseChannels, const T threshold)
+    {
+        try
+        {
+            mNumberSparseChannels = {numberSparseChannels};
+            mSparseThreshold = {threshold};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void ResizeAndMergeCaffe<T>::Forward_cpu(const std::vector<caffe::Blob<T>*>& bottom, const std::vector<caffe::Blob<T>*>& top)
     {
         try
         {
+            if (!mTileOffsets.empty())
+                error("ResizeAndMergeCaffe CPU version of the tiled mode not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
             resizeAndMergeCpu(top.at(0)->mutable_cpu_data(), bottom.at(0)->cpu_data(), mTopSize, mBottomSize, mScaleRatios);
         }
         catch (const std::exception& e)
@@ -86,7 +143,24 @@ namespace op
     {
         try
         {
-            resizeAndMergeGpu(top.at(0)->mutable_gpu_data(), bottom.at(0)->gpu_data(), mTopSize, mBottomSize, mScaleRatios);
+            if (!mTileOffsets.empty())
+            {
+                const auto tileParametersSize = 2 * mTileOffsets.size() + mScaleRatios.size();
+                if (mTileParameters.getVolume() < tileParametersSize)
+                    mTileParameters.reset((int)tileParametersSize);
+                resizeAndMergeTilesGpu(top.at(0)->mutable_gpu_data(), mTileParameters.getPtr(), bottom.at(0)->gpu_data(), mTopSize,
+                                       mBottomSize, mTileOffsets, mTileSize, mTileFactor, mScaleRatios);
+            }
+            else if (mNumberSparseChannels > 0 && mBottomSize[0] == 1 && mTopSize[0] == 1)
+            {
+                const auto tileMaskSize = getResizeAndMergeSparseMaskSize(mBottomSize, mNumberSparseChannels);
+                if (mTileMask.getVolume() < (size_t)tileMaskSize)
+                    mTileMask.reset(tileMaskSize);
+                resizeAndMergeSparseGpu(top.at(0)->mutable_gpu_data(), mTileMask.getPtr(), bottom.at(0)->gpu_data(), mTopSize,
+                                        mBottomSize, mNumberSparseChannels, mSparseThreshold);
+            }
+            else
+                resizeAndMergeGpu(top.at(0)->mutable_gpu_data(), bottom.at(0)->gpu_data(), mTopSize, mBottomSize, mScaleRatios);
         }
         catch (const std::exception& e)
         {
@@ -200,7 +200,8 @@ namespace op
         }
     }
 
-	void FaceExtractor::forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput) {
+	void FaceExtractor::forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput,
+		const std::vector<cv::cuda::GpuMat>& inputPyramid, const std::vector<double>& inputPyramidScales) {
 		try
 		{
 			if (!faceRectangles.empty())
@@ -248,10 +249,18 @@ namespace op
 						Mscaling.at<double>(0, 2) = faceRectangle.x;
 						Mscaling.at<double>(1, 2) = faceRectangle.y;
 
-						
-
-						cv::cuda::warpAffine(cvInputData, faceGpuImage, Mscaling, cv::Size{ mNetOutputSize.x, mNetOutputSize.y },
-							CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+						// Smallest pyramid level with at least 1 pixel per net input pixel (the matrix maps net input -> image)
+						const auto level = getPyramidLevel(inputPyramidScales, scaleFace);
+						if (level >= 0)
+						{
+							// Temporary matrix, Mscaling still maps the net peaks to the input image below
+							const cv::Mat levelMscaling = inputPyramidScales[level] * Mscaling;
+							cv::cuda::warpAffine(inputPyramid[level], faceGpuImage, levelMscaling, cv::Size{ mNetOutputSize.x, mNetOutputSize.y },
+								CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+						}
+						else
+							cv::cuda::warpAffine(cvInputData, faceGpuImage, Mscaling, cv::Size{ mNetOutputSize.x, mNetOutputSize.y },
+								CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
 
 						// cv::Mat -> float*
 						uCharGpuMatToFloatPtr(mFaceImageCrop.getPtr(), faceGpuImage, true);
@@ -0,0 +1,128 @@
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/face/faceKeypointCache.hpp>
+
+namespace op
+{
+    FaceKeypointCache::FaceKeypointCache(const float minIou, const int refreshInterval) :
+        mMinIou{minIou},
+        mRefreshInterval{refreshInterval}
+    {
+        try
+        {
+            if (mMinIou <= 0.f || mMinIou > 1.f)
+                error("The minimum IoU must be in the range (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            if (mRefreshInterval < 1)
+                error("The refresh interval must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<bool> FaceKeypointCache::lookUp(const std::vector<Rectangle<float>>& faceRectangles)
+    {
+        try
+        {
+            std::vector<bool> reusedFaces(faceRectangles.size(), false);
+            mMatches.assign(faceRectangles.size(), -1);
+            std::vector<bool> previousMatched(mFaceRectangles.size(), false);
+            for (auto face = 0u ; face < faceRectangles.size() ; face++)
+            {
+                if (faceRectangles[face].area() > 0)
+                {
+                    // Best unmatched previous face
+                    auto bestIou = mMinIou;
+                    for (auto previous = 0u ; previous < mFaceRectangles.size() ; previous++)
+                    {
+                        if (!previousMatched[previous] && mFaceRectangles[previous].area() > 0)
+                        {
+                            const auto iou = getIou(faceRectangles[face], mFaceRectangles[previous]);
+                            if (iou >= bestIou)
+                            {
+                                bestIou = iou;
+                                mMatches[face] = previous;
+                            }
+                        }
+                    }
+                    // Reuse it unless it must be refreshed (its age is the number of consecutive frames it was already reused)
+                    if (mMatches[face] >= 0)
+                    {
+                        previousMatched[mMatches[face]] = true;
+                        reusedFaces[face] = (mAges[mMatches[face]] < mRefreshInterval);
+                    }
+                }
+            }
+            return reusedFaces;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::vector<bool>{};
+        }
+    }
+
+    void FaceKeypointCache::update(Array<float>& faceKeypoints, const std::vector<Rectangle<float>>& faceRectangles,
+                                   const std::vector<bool>& reusedFaces, const float scaleInputToOutput)
+    {
+        try
+        {
+            const auto numberFaces = (faceKeypoints.empty() ? 0 : faceKeypoints.getSize(0));
+            if (numberFaces != (int)faceRectangles.size() || reusedFaces.size() != faceRectangles.size()
+                || mMatches.size() != faceRectangles.size())
+            {
+                // Nothing to reuse (e.g. no faces) -> Reset the cache
+                mFaceRectangles.clear();
+                mAges.clear();
+                mFaceKeypoints.reset();
+                return;
+            }
+            // Fill the reused faces
+            const auto numberKeypoints = faceKeypoints.getSize(1);
+            const auto faceVolume = numberKeypoints * faceKeypoints.getSize(2);
+            std::vector<int> ages(numberFaces, 0);
+            for (auto face = 0 ; face < numberFaces ; face++)
+            {
+                if (reusedFaces[face])
+                {
+                    const auto previous = mMatches[face];
+                    const auto& rectangle = faceRectangles[face];
+                    const auto& previousRectangle = mFaceRectangles[previous];
+                    const auto scaleX = rectangle.width / previousRectangle.width;
+                    const auto scaleY = rectangle.height / previousRectangle.height;
+                    // Rectangles in input resolution, keypoints in output resolution
+                    const auto x = rectangle.x * scaleInputToOutput;
+                    const auto y = rectangle.y * scaleInputToOutput;
+                    const auto previousX = previousRectangle.x * scaleInputToOutput;
+                    const auto previousY = previousRectangle.y * scaleInputToOutput;
+                    auto* faceKeypointsPtr = &faceKeypoints[face * faceVolume];
+                    const auto* previousKeypointsPtr = &mFaceKeypoints[previous * faceVolume];
+                    for (auto part = 0 ; part < faceVolume ; part+=3)
+                    {
+                        faceKeypointsPtr[part+2] = previousKeypointsPtr[part+2];
+                        if (previousKeypointsPtr[part+2] > 0.f)
+                        {
+                            faceKeypointsPtr[part] = x + (previousKeypointsPtr[part] - previousX) * scaleX;
+                            faceKeypointsPtr[part+1] = y + (previousKeypointsPtr[part+1] - previousY) * scaleY;
+                        }
+                        else
+                        {
+                            faceKeypointsPtr[part] = previousKeypointsPtr[part];
+                            faceKeypointsPtr[part+1] = previousKeypointsPtr[part+1];
+                        }
+                    }
+                    ages[face] = mAges[previous] + 1;
+                }
+            }
+            // Cache the current frame
+            mFaceRectangles = faceRectangles;
+            mAges = ages;
+            mFaceKeypoints = faceKeypoints.clone();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
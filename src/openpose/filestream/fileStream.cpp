@@ -1,4 +1,8 @@
-#include <opencv2/highgui/highgui.hpp> // cv::imread
+#include <algorithm> // std::max, std::min
+#include <fstream> // std::ifstream
+#include <iterator> // std::istreambuf_iterator
+#include <limits> // std::numeric_limits
+#include <opencv2/highgui/highgui.hpp> // cv::imread, cv::imdecode
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
 #include <openpose/filestream/fileStream.hpp>
@@ -38,6 +42,90 @@ namespace op
         return fileNameNoExtension + "." + dataFormatToString(format);
     }
 
+    namespace
+    {
+        Point<int> getJpegResolution(const std::vector<unsigned char>& buffer)
+        {
+            try
+            {
+                // Not a JPEG file (SOI marker)
+                if (buffer.size() < 4 || buffer[0] != 0xFF || buffer[1] != 0xD8)
+                    return Point<int>{0,0};
+                // Walk the marker segments until the SOFn one (frame header), without decoding any entropy-coded data
+                auto index = 2ull;
+                while (index + 3 < buffer.size())
+                {
+                    if (buffer[index] != 0xFF)
+                        return Point<int>{0,0};
+                    const auto marker = buffer[index+1];
+                    // Fill bytes
+                    if (marker == 0xFF)
+                    {
+                        index++;
+                        continue;
+                    }
+                    // Standalone markers (TEM, RSTn)
+                    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+                    {
+                        index += 2;
+                        continue;
+                    }
+                    // End of image or start of scan before any frame header
+                    if (marker == 0xD9 || marker == 0xDA)
+                        return Point<int>{0,0};
+                    const auto segmentLength = (buffer[index+2] << 8) + buffer[index+3];
+                    // SOFn (except DHT, JPG and DAC): length (2), precision (1), height (2), width (2)
+                    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+                    {
+                        if (index + 8 >= buffer.size())
+                            return Point<int>{0,0};
+                        return Point<int>{(buffer[index+7] << 8) + buffer[index+8], (buffer[index+5] << 8) + buffer[index+6]};
+                    }
+                    index += 2 + segmentLength;
+                }
+                return Point<int>{0,0};
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return Point<int>{0,0};
+            }
+        }
+
+        int getJpegReduction(const Point<int>& resolution, const std::vector<Point<int>>& targetResolutions)
+        {
+            try
+            {
+                if (resolution.area() <= 0 || targetResolutions.empty())
+                    return 1;
+                // Highest scale at which the image is sampled, i.e. the scale to fit it into each target resolution (both orientations)
+                auto maximumScale = 0.;
+                for (const auto& targetResolution : targetResolutions)
+                {
+                    for (const auto& orientedResolution : {resolution, Point<int>{resolution.y, resolution.x}})
+                    {
+                        auto scale = std::numeric_limits<double>::max();
+                        if (targetResolution.x > 0)
+                            scale = std::min(scale, targetResolution.x / (double)orientedResolution.x);
+                        if (targetResolution.y > 0)
+                            scale = std::min(scale, targetResolution.y / (double)orientedResolution.y);
+                        maximumScale = std::max(maximumScale, scale);
+                    }
+                }
+                // Smallest power-of-two reduction (libjpeg DCT scaling) not below it
+                for (const auto reduction : {8, 4, 2})
+                    if (1. / reduction >= maximumScale)
+                        return reduction;
+                return 1;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return 1;
+            }
+        }
+    }
+
 
 
 
@@ -219,4 +307,64 @@ namespace op
             return cv::Mat{};
         }
     }
+
+    std::vector<unsigned char> loadEncodedImage(const std::string& fullFilePath)
+    {
+        try
+        {
+            std::ifstream file{fullFilePath, std::ios::binary};
+            return std::vector<unsigned char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    cv::Mat decodeImageReduced(double& scale, const std::vector<unsigned char>& encodedImage,
+                               const std::vector<Point<int>>& targetResolutions)
+    {
+        try
+        {
+            scale = 1.;
+            // The JPEG header is parsed from the same buffer, without a second file access
+            const auto resolution = getJpegResolution(encodedImage);
+            const auto reduction = getJpegReduction(resolution, targetResolutions);
+            // cv::IMREAD_REDUCED_COLOR_X only available in OpenCV >= 3.2
+            #if CV_MAJOR_VERSION > 3 || (CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION >= 2)
+                const auto openCvFlags = (reduction == 8 ? cv::IMREAD_REDUCED_COLOR_8
+                                          : reduction == 4 ? cv::IMREAD_REDUCED_COLOR_4
+                                          : reduction == 2 ? cv::IMREAD_REDUCED_COLOR_2 : CV_LOAD_IMAGE_COLOR);
+            #else
+                const auto openCvFlags = CV_LOAD_IMAGE_COLOR;
+            #endif
+            cv::Mat cvMat = (encodedImage.empty() ? cv::Mat{} : cv::imdecode(encodedImage, openCvFlags));
+            // Orientation-independent (the EXIF orientation might transpose the decoded image)
+            if (!cvMat.empty() && resolution.area() > 0)
+                scale = std::max(cvMat.cols, cvMat.rows) / (double)std::max(resolution.x, resolution.y);
+            return cvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
+
+    cv::Mat loadImageReduced(double& scale, const std::string& fullFilePath, const std::vector<Point<int>>& targetResolutions)
+    {
+        try
+        {
+            cv::Mat cvMat = decodeImageReduced(scale, loadEncodedImage(fullFilePath), targetResolutions);
+            if (cvMat.empty())
+                log("Empty image on path: " + fullFilePath + ".", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            return cvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
 }
@@ -1,3 +1,9 @@
+#include <algorithm> // std::fill
+#include <cmath> // std::floor
+#include <limits> // std::numeric_limits
+#include <numeric> // std::iota
+#include <tuple>
+#include <unordered_map>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
@@ -86,41 +92,226 @@ namespace op
         }
     }
 
-    void trackHand(Rectangle<float>& currentRectangle, const std::vector<Rectangle<float>>& previousHands)
+    namespace
     {
-        try
+        // Minimum cost assignment (Hungarian algorithm) of a size x size cost matrix (row-major). It returns the column assigned to
+        // each row
+        std::vector<int> getMinCostAssignment(const std::vector<float>& costs, const int size)
         {
-            if (currentRectangle.area() > 0 && previousHands.size() > 0)
+            try
             {
-                // Find closest previous rectangle
-                auto maxIndex = -1;
-                auto maxValue = 0.f;
-                for (auto previous = 0 ; previous < previousHands.size() ; previous++)
+                // 1-based potentials and matching, index 0 is the virtual starting column
+                const auto infinity = std::numeric_limits<float>::max();
+                std::vector<float> rowPotentials(size+1, 0.f);
+                std::vector<float> columnPotentials(size+1, 0.f);
+                std::vector<float> minSlacks(size+1);
+                std::vector<int> columnRows(size+1, 0);
+                std::vector<int> previousColumns(size+1, 0);
+                std::vector<bool> usedColumns(size+1);
+                for (auto row = 1 ; row <= size ; row++)
                 {
-                    const auto areaRatio = getAreaRatio(currentRectangle, previousHands[previous]);
-                    if (maxValue < areaRatio)
+                    columnRows[0] = row;
+                    auto column = 0;
+                    std::fill(minSlacks.begin(), minSlacks.end(), infinity);
+                    std::fill(usedColumns.begin(), usedColumns.end(), false);
+                    // Find augmenting path
+                    do
+                    {
+                        usedColumns[column] = true;
+                        const auto currentRow = columnRows[column];
+                        auto delta = infinity;
+                        auto nextColumn = 0;
+                        for (auto j = 1 ; j <= size ; j++)
+                        {
+                            if (!usedColumns[j])
+                            {
+                                const auto slack = costs[(currentRow-1)*size + j-1] - rowPotentials[currentRow] - columnPotentials[j];
+                                if (slack < minSlacks[j])
+                                {
+                                    minSlacks[j] = slack;
+                                    previousColumns[j] = column;
+                                }
+                                if (minSlacks[j] < delta)
+                                {
+                                    delta = minSlacks[j];
+                                    nextColumn = j;
+                                }
+                            }
+                        }
+                        for (auto j = 0 ; j <= size ; j++)
+                        {
+                            if (usedColumns[j])
+                            {
+                                rowPotentials[columnRows[j]] += delta;
+                                columnPotentials[j] -= delta;
+                            }
+                            else
+                                minSlacks[j] -= delta;
+                        }
+                        column = nextColumn;
+                    } while (columnRows[column] != 0);
+                    // Augment matching
+                    do
                     {
-                        maxValue = areaRatio;
-                        maxIndex = previous;
+                        const auto previousColumn = previousColumns[column];
+                        columnRows[column] = columnRows[previousColumn];
+                        column = previousColumn;
+                    } while (column != 0);
+                }
+                std::vector<int> assignment(size);
+                for (auto j = 1 ; j <= size ; j++)
+                    assignment[columnRows[j]-1] = j-1;
+                return assignment;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return std::vector<int>{};
+            }
+        }
+
+        inline int findRoot(std::vector<int>& parents, int node)
+        {
+            while (parents[node] != node)
+                node = parents[node] = parents[parents[node]];
+            return node;
+        }
+
+        inline long long getCellKey(const int cellX, const int cellY)
+        {
+            return ((long long)cellX << 32) | (unsigned int)cellY;
+        }
+
+        void trackHand(Rectangle<float>& currentRectangle, const Rectangle<float>& prevRectangle)
+        {
+            try
+            {
+                const auto ratio = 2.f;
+                const auto newWidth = fastMax((currentRectangle.width * ratio + prevRectangle.width) * 0.5f,
+                                              (currentRectangle.height * ratio + prevRectangle.height) * 0.5f);
+                currentRectangle.x = 0.5f * (currentRectangle.x + prevRectangle.x + 0.5f * (currentRectangle.width + prevRectangle.width) - newWidth);
+                currentRectangle.y = 0.5f * (currentRectangle.y + prevRectangle.y + 0.5f * (currentRectangle.height + prevRectangle.height) - newWidth);
+                currentRectangle.width = newWidth;
+                currentRectangle.height = newWidth;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // One-to-one association (maximizing the summed getAreaRatio) of the current hands of one side with the previous ones.
+        // Candidate pairs are found with a spatial grid (cells as big as the biggest previous hand), and each connected group of
+        // candidates is solved with the Hungarian algorithm (these groups are usually tiny, so it scales linearly with the number of
+        // people).
+        void trackHands(std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const int side,
+                        const std::vector<Rectangle<float>>& previousHands)
+        {
+            try
+            {
+                if (handRectangles.empty() || previousHands.empty())
+                    return;
+                const auto numberCurrent = (int)handRectangles.size();
+                const auto numberPrevious = (int)previousHands.size();
+                // Spatial grid of previous hands
+                auto cellSize = 1.f;
+                for (const auto& previousHand : previousHands)
+                    cellSize = fastMax(cellSize, fastMax(previousHand.width, previousHand.height));
+                std::unordered_map<long long, std::vector<int>> grid;
+                for (auto previous = 0 ; previous < numberPrevious ; previous++)
+                {
+                    const auto& previousHand = previousHands[previous];
+                    const auto bottomRight = previousHand.bottomRight();
+                    const auto lastCellX = (int)std::floor(bottomRight.x / cellSize);
+                    const auto lastCellY = (int)std::floor(bottomRight.y / cellSize);
+                    for (auto cellY = (int)std::floor(previousHand.y / cellSize) ; cellY <= lastCellY ; cellY++)
+                        for (auto cellX = (int)std::floor(previousHand.x / cellSize) ; cellX <= lastCellX ; cellX++)
+                            grid[getCellKey(cellX, cellY)].emplace_back(previous);
+                }
+                // Candidate pairs (current, previous, area ratio) and their connected groups (union-find, previous hands after current
+                // ones)
+                std::vector<std::tuple<int, int, float>> candidates;
+                std::vector<int> parents(numberCurrent + numberPrevious);
+                std::iota(parents.begin(), parents.end(), 0);
+                std::vector<int> lastVisited(numberPrevious, -1);
+                for (auto current = 0 ; current < numberCurrent ; current++)
+                {
+                    const auto& currentHand = handRectangles[current][side];
+                    if (currentHand.area() > 0)
+                    {
+                        const auto bottomRight = currentHand.bottomRight();
+                        const auto lastCellX = (int)std::floor(bottomRight.x / cellSize);
+                        const auto lastCellY = (int)std::floor(bottomRight.y / cellSize);
+                        for (auto cellY = (int)std::floor(currentHand.y / cellSize) ; cellY <= lastCellY ; cellY++)
+                        {
+                            for (auto cellX = (int)std::floor(currentHand.x / cellSize) ; cellX <= lastCellX ; cellX++)
+                            {
+                                const auto cell = grid.find(getCellKey(cellX, cellY));
+                                if (cell != grid.end())
+                                {
+                                    for (const auto previous : cell->second)
+                                    {
+                                        if (lastVisited[previous] != current)
+                                        {
+                                            lastVisited[previous] = current;
+                                            const auto areaRatio = getAreaRatio(currentHand, previousHands[previous]);
+                                            if (areaRatio > 0.f)
+                                            {
+                                                candidates.emplace_back(std::make_tuple(current, previous, areaRatio));
+                                                parents[findRoot(parents, current)] = findRoot(parents, numberCurrent + previous);
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
                     }
                 }
-                // Update current rectangle with closest previous rectangle
-                if (maxIndex > -1)
+                // Group candidates by connected group
+                std::unordered_map<int, std::vector<int>> groups;
+                for (auto candidate = 0u ; candidate < candidates.size() ; candidate++)
+                    groups[findRoot(parents, std::get<0>(candidates[candidate]))].emplace_back(candidate);
+                // Optimal assignment of each group
+                std::vector<int> localIndexes(numberCurrent + numberPrevious, -1);
+                for (const auto& group : groups)
                 {
-                    const auto& prevRectangle = previousHands[maxIndex];
-                    const auto ratio = 2.f;
-                    const auto newWidth = fastMax((currentRectangle.width * ratio + prevRectangle.width) * 0.5f,
-                                                  (currentRectangle.height * ratio + prevRectangle.height) * 0.5f);
-                    currentRectangle.x = 0.5f * (currentRectangle.x + prevRectangle.x + 0.5f * (currentRectangle.width + prevRectangle.width) - newWidth);
-                    currentRectangle.y = 0.5f * (currentRectangle.y + prevRectangle.y + 0.5f * (currentRectangle.height + prevRectangle.height) - newWidth);
-                    currentRectangle.width = newWidth;
-                    currentRectangle.height = newWidth;
+                    std::vector<int> currents;
+                    std::vector<int> previouses;
+                    for (const auto candidate : group.second)
+                    {
+                        const auto current = std::get<0>(candidates[candidate]);
+                        const auto previous = std::get<1>(candidates[candidate]);
+                        if (localIndexes[current] < 0)
+                        {
+                            localIndexes[current] = (int)currents.size();
+                            currents.emplace_back(current);
+                        }
+                        if (localIndexes[numberCurrent + previous] < 0)
+                        {
+                            localIndexes[numberCurrent + previous] = (int)previouses.size();
+                            previouses.emplace_back(previous);
+                        }
+                    }
+                    // Square cost matrix, non-candidate pairs (or padding) cost 0, i.e. unmatched
+                    const auto size = (int)fastMax(currents.size(), previouses.size());
+                    std::vector<float> costs(size*size, 0.f);
+                    for (const auto candidate : group.second)
+                        costs[localIndexes[std::get<0>(candidates[candidate])] * size
+                              + localIndexes[numberCurrent + std::get<1>(candidates[candidate])]] = -std::get<2>(candidates[candidate]);
+                    const auto assignment = getMinCostAssignment(costs, size);
+                    // Update current rectangles with their assigned previous rectangles
+                    for (auto localCurrent = 0u ; localCurrent < currents.size() ; localCurrent++)
+                    {
+                        const auto localPrevious = assignment[localCurrent];
+                        if (localPrevious < (int)previouses.size() && costs[localCurrent * size + localPrevious] < 0.f)
+                            trackHand(handRectangles[currents[localCurrent]][side], previousHands[previouses[localPrevious]]);
+                    }
                 }
             }
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
         }
     }
 
@@ -169,15 +360,9 @@ namespace op
             std::lock_guard<std::mutex> lock{mMutex};
             // Baseline detectHands
             auto handRectangles = detectHands(poseKeypoints, scaleInputToOutput);
-            // If previous hands saved
-            // for (auto current = 0 ; current < handRectangles.size() ; current++)
-            for (auto& handRectangle : handRectangles)
-            {
-                // trackHand(handRectangles[current][0], mHandLeftPrevious);
-                // trackHand(handRectangles[current][1], mHandRightPrevious);
-                trackHand(handRectangle[0], mHandLeftPrevious);
-                trackHand(handRectangle[1], mHandRightPrevious);
-            }
+            // If previous hands saved, associate them 1-to-1 with the current ones
+            trackHands(handRectangles, 0, mHandLeftPrevious);
+            trackHands(handRectangles, 1, mHandRightPrevious);
             // Return result
             return handRectangles;
         }
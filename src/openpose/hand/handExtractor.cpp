@@ -20,11 +20,10 @@ namespace op
                                          modelFolder + HAND_TRAINED_MODEL, gpuId)},
         spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
         spNmsCaffe{std::make_shared<NmsCaffe<float>>()},
-        mHandImageCrop{mNetOutputSize.area()*3}
+        mHandImageCrop{{1, 3, mNetOutputSize.y, mNetOutputSize.x}}
     {
         try
         {
-error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCTION__, __FILE__);
             checkE(netOutputSize.x, netInputSize.x, "Net input and output size must be equal.", __LINE__, __FUNCTION__, __FILE__);
             checkE(netOutputSize.y, netInputSize.y, "Net input and output size must be equal.", __LINE__, __FUNCTION__, __FILE__);
             checkE(netInputSize.x, netInputSize.y, "Net input size must be squared.", __LINE__, __FUNCTION__, __FILE__);
@@ -55,7 +54,8 @@ error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCT
 
             // HeatMaps extractor blob and layer
             spHeatMapsBlob = {std::make_shared<caffe::Blob<float>>(1,1,1,1)};
-            const bool mergeFirstDimension = true;
+            // Each crop is an independent hand, so the batch dimension is kept
+            const bool mergeFirstDimension = false;
             spResizeAndMergeCaffe->Reshape({spCaffeNetOutputBlob.get()}, {spHeatMapsBlob.get()}, HAND_CCN_DECREASE_FACTOR, mergeFirstDimension);
             cudaCheck(__LINE__, __FUNCTION__, __FILE__);
 
@@ -72,32 +72,79 @@ error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCT
         }
     }
 
-	void  HandExtractor::forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::cuda::GpuMat& cvInputData,
-		const float scaleInputToOutput) {
-	    
-		try
-		{
-			error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCTION__, __FILE__);
-			UNUSED(handRectangles);
-			UNUSED(cvInputData);
-			UNUSED(scaleInputToOutput);
-		}
-		catch (const std::exception& e)
-		{
-			error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-		}
+    void HandExtractor::forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::Mat& cvInputData,
+                                    const float scaleInputToOutput)
+    {
+        try
+        {
+            const auto numberCrops = setCrops(handRectangles);
+            if (numberCrops > 0)
+            {
+                // Security checks
+                if (cvInputData.empty())
+                    error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+                // Crops -> shared mHandImageCrop buffer (N x 3 x H x W)
+                if (mHandImageCrop.getSize(0) < numberCrops)
+                    mHandImageCrop.reset({numberCrops, 3, mNetOutputSize.y, mNetOutputSize.x});
+                const auto cropVolume = mNetOutputSize.area() * 3;
+                cv::Mat handImage;
+                for (auto crop = 0 ; crop < numberCrops ; crop++)
+                {
+                    cv::warpAffine(cvInputData, handImage, mCropAffineMatrices[crop], cv::Size{mNetOutputSize.x, mNetOutputSize.y},
+                                   CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                    // cv::Mat -> float*
+                    uCharCvMatToFloatPtr(mHandImageCrop.getPtr() + crop * cropVolume, handImage, true);
+                }
+
+                // Single copy of the whole batch
+                reshapeBatch(numberCrops);
+                cudaMemcpy(spNet->getInputDataGpuPtr(), mHandImageCrop.getPtr(), numberCrops * cropVolume * sizeof(float),
+                           cudaMemcpyHostToDevice);
 
+                forwardPassBatch(numberCrops, scaleInputToOutput);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
-    void HandExtractor::forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::Mat& cvInputData,
-                                    const float scaleInputToOutput)
+    void HandExtractor::forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::cuda::GpuMat& cvInputData,
+                                    const float scaleInputToOutput, const std::vector<cv::cuda::GpuMat>& inputPyramid,
+                                    const std::vector<double>& inputPyramidScales)
     {
         try
         {
-error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCTION__, __FILE__);
-            UNUSED(handRectangles);
-            UNUSED(cvInputData);
-            UNUSED(scaleInputToOutput);
+            const auto numberCrops = setCrops(handRectangles);
+            if (numberCrops > 0)
+            {
+                // Security checks
+                if (cvInputData.empty())
+                    error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+                // Crops are written directly into the GPU net input blob (N x 3 x H x W), no host round trip
+                reshapeBatch(numberCrops);
+                auto* inputDataGpuPtr = spNet->getInputDataGpuPtr();
+                const auto cropVolume = mNetOutputSize.area() * 3;
+                for (auto crop = 0 ; crop < numberCrops ; crop++)
+                {
+                    // Smallest pyramid level with at least 1 pixel per net input pixel (mCropAffineMatrices map net input -> image)
+                    const auto& cropAffineMatrix = mCropAffineMatrices[crop];
+                    const auto level = getPyramidLevel(inputPyramidScales, cropAffineMatrix.at<double>(1,1));
+                    if (level >= 0)
+                        cv::cuda::warpAffine(inputPyramid[level], mHandGpuImage, inputPyramidScales[level] * cropAffineMatrix,
+                                             cv::Size{mNetOutputSize.x, mNetOutputSize.y}, CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
+                                             cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                    else
+                        cv::cuda::warpAffine(cvInputData, mHandGpuImage, cropAffineMatrix, cv::Size{mNetOutputSize.x, mNetOutputSize.y},
+                                             CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                    uCharGpuMatToFloatPtr(inputDataGpuPtr, mHandGpuImage, true, crop * cropVolume);
+                }
+
+                forwardPassBatch(numberCrops, scaleInputToOutput);
+            }
         }
         catch (const std::exception& e)
         {
@@ -169,17 +216,154 @@ error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCT
         }
     }
 
+    int HandExtractor::setCrops(const std::vector<std::array<Rectangle<float>, 2>>& handRectangles)
+    {
+        try
+        {
+            // Set hand size
+            const auto numberPeople = (int)handRectangles.size();
+            for (auto& handKeypoints : mHandKeypoints)
+            {
+                if (numberPeople > 0)
+                    handKeypoints.reset({numberPeople, (int)HAND_NUMBER_PARTS, 3}, 0);
+                else
+                    handKeypoints.reset();
+            }
+
+            // Left hands first, then right hands. Right hands are horizontally mirrored, so the whole batch looks like left hands
+            const auto netInputSide = fastMin(mNetOutputSize.x, mNetOutputSize.y);
+            mCropIndexes.clear();
+            mCropAffineMatrices.clear();
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto& handRectangle = handRectangles.at(person).at(hand);
+                    if (handRectangle.width > 0 && handRectangle.height > 0)
+                    {
+                        // Inverse map: image = M * (net input)
+                        const auto handSize = fastMax(handRectangle.width, handRectangle.height);
+                        const double scaleHand = handSize / (double)netInputSide;
+                        cv::Mat Mscaling = cv::Mat::eye(2, 3, CV_64F);
+                        Mscaling.at<double>(0,0) = (hand == 0 ? scaleHand : -scaleHand);
+                        Mscaling.at<double>(1,1) = scaleHand;
+                        Mscaling.at<double>(0,2) = handRectangle.x + (hand == 0 ? 0. : scaleHand * (mNetOutputSize.x - 1));
+                        Mscaling.at<double>(1,2) = handRectangle.y;
+                        mCropIndexes.emplace_back(std::array<int, 2>{person, hand});
+                        mCropAffineMatrices.emplace_back(Mscaling);
+                    }
+                }
+            }
+            return (int)mCropIndexes.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    void HandExtractor::reshapeBatch(const int numberCrops)
+    {
+        try
+        {
+            // Blobs only reallocate memory if the batch grows over its maximum historical size
+            if (spCaffeNetOutputBlob->shape(0) != numberCrops)
+            {
+                ((NetCaffe*)spNet.get())->reshape({numberCrops, 3, mNetOutputSize.y, mNetOutputSize.x});
+                const bool mergeFirstDimension = false;
+                spResizeAndMergeCaffe->Reshape({spCaffeNetOutputBlob.get()}, {spHeatMapsBlob.get()}, HAND_CCN_DECREASE_FACTOR,
+                                               mergeFirstDimension);
+                spNmsCaffe->Reshape({spHeatMapsBlob.get()}, {spPeaksBlob.get()}, HAND_MAX_PEAKS, HAND_NUMBER_PARTS+1);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HandExtractor::forwardPassBatch(const int numberCrops, const float scaleInputToOutput)
+    {
+        try
+        {
+            // 1. Caffe deep network
+            spNet->forwardPass();
+
+            // 2. Resize heat maps (batch dimension kept)
+            #ifndef CPU_ONLY
+                spResizeAndMergeCaffe->Forward_gpu({spCaffeNetOutputBlob.get()}, {spHeatMapsBlob.get()});
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                spResizeAndMergeCaffe->Forward_cpu({spCaffeNetOutputBlob.get()}, {spHeatMapsBlob.get()});
+            #endif
+
+            // 3. Get peaks by Non-Maximum Suppression
+            spNmsCaffe->setThreshold((float)get(HandProperty::NMSThreshold));
+            #ifndef CPU_ONLY
+                spNmsCaffe->Forward_gpu({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                spNmsCaffe->Forward_cpu({spHeatMapsBlob.get()}, {spPeaksBlob.get()});
+            #endif
+
+            // 4. Peaks -> keypoints, mapped back through each crop transformation
+            const auto handPeaksCropOffset = (HAND_NUMBER_PARTS+1) * (HAND_MAX_PEAKS+1) * 3;
+            for (auto crop = 0 ; crop < numberCrops ; crop++)
+            {
+                const auto& cropIndex = mCropIndexes[crop];
+                detectHandKeypoints(mHandKeypoints[cropIndex[1]], scaleInputToOutput, cropIndex[0], mCropAffineMatrices[crop],
+                                    crop * handPeaksCropOffset);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void HandExtractor::detectHandKeypoints(Array<float>& handCurrent, const float scaleInputToOutput, const int person,
                                             const cv::Mat& affineMatrix, const unsigned int handPeaksOffset)
     {
         try
         {
-error("Hands extraction is not implemented yet. COMING SOON!", __LINE__, __FUNCTION__, __FILE__);
-            UNUSED(handCurrent);
-            UNUSED(scaleInputToOutput);
-            UNUSED(person);
-            UNUSED(affineMatrix);
-            UNUSED(handPeaksOffset);
+            const auto* handPeaksPtr = spPeaksBlob->mutable_cpu_data() + handPeaksOffset;
+            const auto handPeaksPartOffset = (HAND_MAX_PEAKS+1) * 3;
+
+            for (auto part = 0 ; part < handCurrent.getSize(1) ; part++)
+            {
+                // Get max peak
+                const int numPeaks = intRound(handPeaksPtr[handPeaksPartOffset*part]);
+                auto maxScore = -1.f;
+                auto maxPeak = -1;
+                for (auto peak = 0 ; peak < numPeaks ; peak++)
+                {
+                    const auto xyIndex = handPeaksPartOffset * part + (1 + peak) * 3;
+                    const auto score = handPeaksPtr[xyIndex + 2];
+                    if (score > maxScore)
+                    {
+                        maxScore = score;
+                        maxPeak = peak;
+                    }
+                }
+                // Fill hand keypoints (the affine matrix already undoes the right hand mirroring)
+                if (maxPeak >= 0)
+                {
+                    const auto xyIndex = handPeaksPartOffset * part + (1 + maxPeak) * 3;
+                    const auto x = handPeaksPtr[xyIndex];
+                    const auto y = handPeaksPtr[xyIndex + 1];
+                    const auto score = handPeaksPtr[xyIndex + 2];
+                    const auto baseIndex = handCurrent.getSize(2) * (person * handCurrent.getSize(1) + part);
+                    handCurrent[baseIndex] = (float)(scaleInputToOutput * (affineMatrix.at<double>(0,0) * x
+                                                                           + affineMatrix.at<double>(0,1) * y
+                                                                           + affineMatrix.at<double>(0,2)));
+                    handCurrent[baseIndex+1] = (float)(scaleInputToOutput * (affineMatrix.at<double>(1,0) * x
+                                                                             + affineMatrix.at<double>(1,1) * y
+                                                                             + affineMatrix.at<double>(1,2)));
+                    handCurrent[baseIndex+2] = score;
+                }
+            }
         }
         catch (const std::exception& e)
         {
@@ -3,5 +3,9 @@
 namespace op
 {
     DEFINE_TEMPLATE_DATUM(WPoseExtractor);
+    DEFINE_TEMPLATE_DATUM(WPoseExtractorCascade);
+    DEFINE_TEMPLATE_DATUM(WPoseExtractorRoi);
+    DEFINE_TEMPLATE_DATUM(WPoseExtractorTiled);
+    DEFINE_TEMPLATE_DATUM(WPoseExtractorTracking);
     DEFINE_TEMPLATE_DATUM(WPoseRenderer);
 }
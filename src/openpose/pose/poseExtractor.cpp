@@ -3,6 +3,9 @@
 #include <openpose/core/enumClasses.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/macros.hpp>
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/pose/poseExtractor.hpp>
 
 namespace op
@@ -195,6 +198,20 @@ namespace op
         }
     }
 
+    Point<int> PoseExtractor::getNetOutputSize() const
+    {
+        try
+        {
+            checkThread();
+            return mNetOutputSize;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
     double PoseExtractor::get(const PoseProperty property) const
     {
         try
@@ -232,6 +249,49 @@ namespace op
         }
     }
 
+    void PoseExtractor::setRoiMask(const cv::Mat& roiMask)
+    {
+        try
+        {
+            mRoi = getMaskBoundingBox(roiMask);
+            mRoiMask = (mRoi.area() > 0 ? roiMask.clone() : cv::Mat{});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::forwardPassTiles(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize,
+                                         const std::vector<cv::Rect>& tiles, const std::vector<float>& scaleRatios)
+    {
+        try
+        {
+            UNUSED(inputNetData);
+            UNUSED(inputDataSize);
+            UNUSED(tiles);
+            UNUSED(scaleRatios);
+            error("The tiled forward pass is not implemented for this pose extractor.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::setNetInputSize(const Point<int>& netInputSize)
+    {
+        try
+        {
+            UNUSED(netInputSize);
+            error("Changing the net input resolution is not implemented for this pose extractor.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void PoseExtractor::checkThread() const
     {
         try
@@ -244,4 +304,55 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void PoseExtractor::removePeaksOutsideRoiMask(float* peaksPtr, const double scaleRoiToNet) const
+    {
+        try
+        {
+            // Peaks are in heat map (scaled ROI) coordinates -> frame coordinates to read the mask
+            const auto numberBodyParts = POSE_NUMBER_BODY_PARTS[(int)mPoseModel];
+            const auto maxPeaks = POSE_MAX_PEAKS[(int)mPoseModel];
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto scaleNetToRoi = 1. / scaleRoiToNet;
+            for (auto part = 0u ; part < numberBodyParts ; part++)
+            {
+                auto* partPeaksPtr = peaksPtr + part*peaksOffset;
+                const auto numberPeaks = intRound(partPeaksPtr[0]);
+                auto numberKeptPeaks = 0;
+                for (auto peak = 1 ; peak <= numberPeaks ; peak++)
+                {
+                    const auto* peakPtr = partPeaksPtr + 3*peak;
+                    const auto x = fastTruncate(mRoi.x + intRound(peakPtr[0] * scaleNetToRoi), 0, mRoiMask.cols-1);
+                    const auto y = fastTruncate(mRoi.y + intRound(peakPtr[1] * scaleNetToRoi), 0, mRoiMask.rows-1);
+                    if (mRoiMask.at<unsigned char>(y, x) != 0)
+                    {
+                        numberKeptPeaks++;
+                        if (numberKeptPeaks != peak)
+                            std::copy(peakPtr, peakPtr + 3, partPeaksPtr + 3*numberKeptPeaks);
+                    }
+                }
+                partPeaksPtr[0] = (float)numberKeptPeaks;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::scaleRoiKeypointsToFrame(const Point<int>& inputDataSize, const double scaleRoiToNet)
+    {
+        try
+        {
+            // Keypoints = roiCoordinates * scaleRoiToNet * scaleNetToOutput -> frameCoordinates * scaleInputToOutput
+            const auto scaleInputToOutput = (float)resizeGetScaleFactor(inputDataSize, mOutputSize);
+            const auto scaleRoiToOutput = scaleInputToOutput / ((float)scaleRoiToNet * mScaleNetToOutput);
+            scaleKeypoints(mPoseKeypoints, scaleRoiToOutput, scaleRoiToOutput, mRoi.x * scaleInputToOutput, mRoi.y * scaleInputToOutput);
+            mScaleNetToOutput = scaleInputToOutput / (float)scaleRoiToNet;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -8,6 +8,7 @@
 #include "openpose/utilities/openCv.hpp"
 #include "openpose/pose/poseExtractorCaffe.hpp"
 #include <openpose/core/netCaffe.hpp>
+#include <openpose/core/resizeAndMergeBase.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/cuda.hpp>
@@ -30,13 +31,14 @@ namespace op
     
 	PoseExtractorCaffe::PoseExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize, const Point<int>& outputSize, const int scaleNumber,
 		const PoseModel poseModel, const std::string& modelFolder, const int gpuId, const std::vector<HeatMapType>& heatMapTypes,
-		const ScaleMode heatMapScale) :
+		const ScaleMode heatMapScale, const bool sparseHeatMaps, const bool parallelScales) :
 		PoseExtractor{ netOutputSize, outputSize, poseModel, heatMapTypes, heatMapScale },
 		mResizeScale{ mNetOutputSize.x / (float)netInputSize.x },
+		mSparseHeatMaps{ sparseHeatMaps },
 		mNetInputSize4D{ scaleNumber, 3, (int)netInputSize.x, (int)netInputSize.y },
 		mNetInputMemory{ std::accumulate(mNetInputSize4D.begin(), mNetInputSize4D.end(), 1, std::multiplies<int>()) * sizeof(float) },
 		spNet{ std::make_shared<NetCaffe>(std::array<int,4>{scaleNumber, 3, (int)netInputSize.y, (int)netInputSize.x},
-			modelFolder + POSE_PROTOTXT[(int)poseModel], modelFolder + POSE_TRAINED_MODEL[(int)poseModel], gpuId) },
+			modelFolder + POSE_PROTOTXT[(int)poseModel], modelFolder + POSE_TRAINED_MODEL[(int)poseModel], gpuId, "net_output", parallelScales) },
 		spResizeAndMergeCaffe{ std::make_shared<ResizeAndMergeCaffe<float>>() },
 		spNmsCaffe{ std::make_shared<NmsCaffe<float>>() },
 		spBodyPartConnectorCaffe{ std::make_shared<BodyPartConnectorCaffe<float>>() }
@@ -93,19 +95,77 @@ namespace op
         }
     }
 
-    void PoseExtractorCaffe::forwardPassInternal(const Point<int>& inputDataSize, const std::vector<float>& scaleRatios) {
-	
+    void PoseExtractorCaffe::forwardPassInternal(const Point<int>& inputDataSize, const std::vector<float>& scaleRatios,
+                                                 const std::vector<cv::Rect>& tiles) {
+
+		// Static ROI mask - The network only saw the bounding box of the mask
+		const auto useRoiMask = (mRoi.area() > 0);
+		if (useRoiMask && (inputDataSize.x != mRoiMask.cols || inputDataSize.y != mRoiMask.rows))
+			error("The ROI mask and the input frames must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
+		const auto netInputDataSize = (useRoiMask ? Point<int>{ mRoi.width, mRoi.height } : inputDataSize);
+
+		// Get scale net to output
+		// Tiles - The heat maps cover the whole frame, at the net input resolution of the tiles
+		const auto scaleDataSize = (tiles.empty() ? netInputDataSize : Point<int>{ tiles[0].width, tiles[0].height });
+		const auto scaleProducerToNetInput = resizeGetScaleFactor(scaleDataSize, mNetOutputSize);
+		const Point<int> netSize{ intRound(scaleProducerToNetInput*netInputDataSize.x), intRound(scaleProducerToNetInput*netInputDataSize.y) };
+		mScaleNetToOutput = { (float)resizeGetScaleFactor(netSize, mOutputSize) };
+		if (!tiles.empty())
+		{
+			std::vector<std::array<float, 2>> tileOffsets(tiles.size());
+			for (auto tile = 0u ; tile < tiles.size() ; tile++)
+				tileOffsets[tile] = { (float)(tiles[tile].x * scaleProducerToNetInput), (float)(tiles[tile].y * scaleProducerToNetInput) };
+			spResizeAndMergeCaffe->setTiles(tileOffsets, { (float)(tiles[0].width * scaleProducerToNetInput),
+			                                               (float)(tiles[0].height * scaleProducerToNetInput) },
+			                                mResizeScale * POSE_CCN_DECREASE_FACTOR[(int)mPoseModel]);
+			// Peaks and pose blobs only reshaped if the frame resolution changes
+			const auto heatMapsShape = spHeatMapsBlob->shape();
+			spResizeAndMergeCaffe->ReshapeTiles({ spCaffeNetOutputBlob.get() }, { spHeatMapsBlob.get() }, netSize.x, netSize.y);
+			if (heatMapsShape != spHeatMapsBlob->shape())
+			{
+				spNmsCaffe->Reshape({ spHeatMapsBlob.get() }, { spPeaksBlob.get() }, POSE_MAX_PEAKS[(int)mPoseModel],
+				                    POSE_NUMBER_BODY_PARTS[(int)mPoseModel]);
+				spBodyPartConnectorCaffe->Reshape({ spHeatMapsBlob.get(), spPeaksBlob.get() }, { spPoseBlob.get() });
+			}
+			cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+		}
+
+		// Early exit - If no body part of the low resolution net output can reach the NMS threshold after being resized (e.g. empty
+		// frame), there cannot be any peak, so the post-processing is skipped (same result than running it)
+		const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
+		const auto& netOutputShape = spCaffeNetOutputBlob->shape();
+		const std::array<int, 4> netOutputSize4D{ netOutputShape[0], netOutputShape[1], netOutputShape[2], netOutputShape[3] };
+		const auto emptyFrame = (resizeAndMergeMaxBoundGpu(spCaffeNetOutputBlob->gpu_data(), netOutputSize4D,
+		                                                   (int)POSE_NUMBER_BODY_PARTS[(int)mPoseModel]) <= nmsThreshold);
+
 		// 2. Resize heat maps + merge different scales
-		spResizeAndMergeCaffe->setScaleRatios(scaleRatios);
+		// If empty frame, only needed if the heat maps are returned, otherwise they are just cleared (e.g. for the heat map rendering)
+		if (!emptyFrame || !mHeatMapTypes.empty())
+		{
+			spResizeAndMergeCaffe->setScaleRatios(scaleRatios);
+			// Sparse body part heat maps (cold areas set to 0), only if they are not returned
+			spResizeAndMergeCaffe->setSparse((mSparseHeatMaps && mHeatMapTypes.empty() ? (int)POSE_NUMBER_BODY_PARTS[(int)mPoseModel] : 0),
+			                                 nmsThreshold);
 #ifndef CPU_ONLY
-		spResizeAndMergeCaffe->Forward_gpu({ spCaffeNetOutputBlob.get() }, { spHeatMapsBlob.get() });       // ~5ms
-		cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+			spResizeAndMergeCaffe->Forward_gpu({ spCaffeNetOutputBlob.get() }, { spHeatMapsBlob.get() });       // ~5ms
+			cudaCheck(__LINE__, __FUNCTION__, __FILE__);
 #else
-		error("ResizeAndMergeCaffe CPU version not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
+			error("ResizeAndMergeCaffe CPU version not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
 #endif
+		}
+		else
+		{
+			cudaMemset(spHeatMapsBlob->mutable_gpu_data(), 0, spHeatMapsBlob->count() * sizeof(float));
+			cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+		}
+		if (emptyFrame)
+		{
+			mPoseKeypoints.reset();
+			return;
+		}
 
 		// 3. Get peaks by Non-Maximum Suppression
-		spNmsCaffe->setThreshold((float)get(PoseProperty::NMSThreshold));
+		spNmsCaffe->setThreshold(nmsThreshold);
 #ifndef CPU_ONLY
 		spNmsCaffe->Forward_gpu({ spHeatMapsBlob.get() }, { spPeaksBlob.get() });                           // ~2ms
 		cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -113,10 +173,9 @@ namespace op
 		error("NmsCaffe CPU version not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
 #endif
 
-		// Get scale net to output
-		const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
-		const Point<int> netSize{ intRound(scaleProducerToNetInput*inputDataSize.x), intRound(scaleProducerToNetInput*inputDataSize.y) };
-		mScaleNetToOutput = { (float)resizeGetScaleFactor(netSize, mOutputSize) };
+		// Ignore peaks outside the ROI mask
+		if (useRoiMask)
+			removePeaksOutsideRoiMask(spPeaksBlob->mutable_cpu_data(), scaleProducerToNetInput);
 
 		// 4. Connecting body parts
 		spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
@@ -128,8 +187,11 @@ namespace op
 		// GPU version not implemented yet
 		spBodyPartConnectorCaffe->Forward_cpu({ spHeatMapsBlob.get(), spPeaksBlob.get() }, mPoseKeypoints);
 		// spBodyPartConnectorCaffe->Forward_gpu({spHeatMapsBlob.get(), spPeaksBlob.get()}, {spPoseBlob.get()}, mPoseKeypoints);
-    }
 
+		// ROI output coordinates -> frame output coordinates
+		if (useRoiMask)
+			scaleRoiKeypointsToFrame(inputDataSize, scaleProducerToNetInput);
+    }
 	void PoseExtractorCaffe::forwardPass(const Array<float>& inputNetData, const Point<int>& inputDataSize, const std::vector<float>& scaleRatios)
     {
         try
@@ -178,6 +240,41 @@ namespace op
 	}
 
 
+	void PoseExtractorCaffe::forwardPassTiles(const GpuArray<float>& inputNetData, const Point<int>& inputDataSize,
+	                                          const std::vector<cv::Rect>& tiles, const std::vector<float>& scaleRatios)
+	{
+		try
+		{
+			// Security checks
+			if (inputNetData.empty() || tiles.empty())
+				error("Empty inputNetData or tiles.", __LINE__, __FUNCTION__, __FILE__);
+			if (mRoi.area() > 0)
+				error("The ROI mask cannot be combined with the tiles.", __LINE__, __FUNCTION__, __FILE__);
+			const auto batchSize = (int)(tiles.size() * scaleRatios.size());
+			if (inputNetData.getSize(0) != batchSize)
+				error("inputNetData must contain every scale of every tile.", __LINE__, __FUNCTION__, __FILE__);
+
+			// All the tiles (and their scales) in a single batch - Only reshaped if the number of tiles changes
+			if (mNetInputSize4D[0] != batchSize)
+			{
+				mNetInputSize4D[0] = batchSize;
+				mNetInputMemory = std::accumulate(mNetInputSize4D.begin(), mNetInputSize4D.end(), 1, std::multiplies<int>()) * sizeof(float);
+				((NetCaffe*)spNet.get())->reshape({batchSize, 3, mNetInputSize4D[3], mNetInputSize4D[2]});
+			}
+			cudaMemcpy(spNet->getInputDataGpuPtr(), inputNetData.getConstPtr(), mNetInputMemory, cudaMemcpyDeviceToDevice);
+			cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+
+			// 1. Caffe deep network
+			spNet->forwardPass();
+
+			forwardPassInternal(inputDataSize, scaleRatios, tiles);
+		}
+		catch (const std::exception& e)
+		{
+			error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+		}
+	}
+
     const float* PoseExtractorCaffe::getHeatMapCpuConstPtr() const
     {
         try
@@ -220,6 +317,36 @@ namespace op
             return nullptr;
         }
     }
+
+    void PoseExtractorCaffe::setNetInputSize(const Point<int>& netInputSize)
+    {
+        try
+        {
+            checkThread();
+            // Same resolution
+            const Point<int> netOutputSize{intRound(netInputSize.x * mResizeScale), intRound(netInputSize.y * mResizeScale)};
+            if (netOutputSize.x == mNetOutputSize.x && netOutputSize.y == mNetOutputSize.y)
+                return;
+            // Security checks
+            if (netInputSize.x % 16 != 0 || netInputSize.y % 16 != 0)
+                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            // Caffe net
+            const auto scaleNumber = mNetInputSize4D[0];
+            mNetInputSize4D = {scaleNumber, 3, netInputSize.x, netInputSize.y};
+            mNetInputMemory = std::accumulate(mNetInputSize4D.begin(), mNetInputSize4D.end(), 1, std::multiplies<int>()) * sizeof(float);
+            ((NetCaffe*)spNet.get())->reshape({scaleNumber, 3, netInputSize.y, netInputSize.x});
+            mNetOutputSize = netOutputSize;
+            // Heat maps, peaks and pose blobs
+            spResizeAndMergeCaffe->Reshape({spCaffeNetOutputBlob.get()}, {spHeatMapsBlob.get()}, mResizeScale * POSE_CCN_DECREASE_FACTOR[(int)mPoseModel]);
+            spNmsCaffe->Reshape({spHeatMapsBlob.get()}, {spPeaksBlob.get()}, POSE_MAX_PEAKS[(int)mPoseModel], POSE_NUMBER_BODY_PARTS[(int)mPoseModel]);
+            spBodyPartConnectorCaffe->Reshape({spHeatMapsBlob.get(), spPeaksBlob.get()}, {spPoseBlob.get()});
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
 
 #endif
@@ -0,0 +1,195 @@
+#include <algorithm> // std::sort
+#include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/pose/poseExtractorCascade.hpp>
+
+namespace op
+{
+    // Threshold to compute the people rectangles (same one than the hand detector tracking)
+    const auto CASCADE_KEYPOINTS_THRESHOLD = 0.25f;
+    // Padding added to each side of the person rectangle, relative to its height (the keypoints do not cover the whole body)
+    const auto CASCADE_CROP_PADDING = 0.5f;
+    // Minimum intersection over union between the first pass person and the crop one to replace its keypoints
+    const auto CASCADE_MIN_IOU = 0.3f;
+
+    PoseExtractorCascade::PoseExtractorCascade(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize,
+                                               const PoseModel poseModel, const int scaleNumber, const float scaleGap,
+                                               const float maxHeightRatio, const int maxCrops) :
+        spPoseExtractor{poseExtractor},
+        mNetInputSize{netInputSize},
+        mNumberBodyParts{POSE_NUMBER_BODY_PARTS[(int)poseModel]},
+        mMaxHeightRatio{maxHeightRatio},
+        mMaxCrops{maxCrops},
+        spCvMatToOpInput{std::make_shared<CvMatToOpInput>(netInputSize, scaleNumber, scaleGap)},
+        mScaleNetToOutput{1.f}
+    {
+        try
+        {
+            if (mMaxHeightRatio <= 0.f || mMaxHeightRatio > 1.f)
+                error("The maximum height ratio must be in the range (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            if (mMaxCrops < 1)
+                error("The maximum number of crops must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCascade::initializationOnThread()
+    {
+        try
+        {
+            spPoseExtractor->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCascade::forwardPass(const GpuArray<float>& inputNetData, const cv::cuda::GpuMat& cvInputData,
+                                           const std::vector<float>& scaleRatios, const float scaleInputToOutput)
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+            // First stage - Whole frame
+            const Point<int> frameSize{cvInputData.cols, cvInputData.rows};
+            spPoseExtractor->forwardPass(inputNetData, frameSize, scaleRatios);
+            mPoseKeypoints = spPoseExtractor->getPoseKeypoints();
+            mHeatMaps = spPoseExtractor->getHeatMaps();
+            mScaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+
+            // Candidates - People smaller than mMaxHeightRatio, the smallest ones first
+            const auto personVolume = 3 * (int)mNumberBodyParts;
+            const auto maxHeight = mMaxHeightRatio * frameSize.y * scaleInputToOutput;
+            std::vector<std::pair<float, int>> candidates;
+            for (auto person = 0 ; person < mPoseKeypoints.getSize(0) ; person++)
+            {
+                const auto personRectangle = getKeypointsRectangle(&mPoseKeypoints[person * personVolume], mNumberBodyParts,
+                                                                   CASCADE_KEYPOINTS_THRESHOLD);
+                if (personRectangle.area() > 0 && personRectangle.height < maxHeight)
+                    candidates.emplace_back(personRectangle.height, person);
+            }
+            std::sort(candidates.begin(), candidates.end());
+            if (candidates.size() > (unsigned int)mMaxCrops)
+                candidates.resize(mMaxCrops);
+
+            // Second stage - Upscaled crop around each candidate
+            for (const auto& candidate : candidates)
+            {
+                auto* personPtr = &mPoseKeypoints[candidate.second * personVolume];
+                const auto personRectangle = getKeypointsRectangle(personPtr, mNumberBodyParts, CASCADE_KEYPOINTS_THRESHOLD);
+                const auto crop = getCrop(personRectangle / scaleInputToOutput, frameSize);
+                if (crop.area() == 0)
+                    continue;
+                const cv::cuda::GpuMat cvInputDataCrop = cvInputData(crop);
+                const auto cropScaleRatios = spCvMatToOpInput->format(mCropNetData, cvInputDataCrop);
+                const Point<int> cropSize{crop.width, crop.height};
+                spPoseExtractor->forwardPass(mCropNetData, cropSize, cropScaleRatios);
+                auto cropKeypoints = spPoseExtractor->getPoseKeypoints();
+                // Keypoints = cropCoordinates * scaleCropToNet * scaleNetToOutput
+                const auto scaleCropToNet = (float)resizeGetScaleFactor(cropSize, mNetInputSize);
+                const auto scaleCropToOutput = scaleInputToOutput / (scaleCropToNet * spPoseExtractor->getScaleNetToOutput());
+                scaleKeypoints(cropKeypoints, scaleCropToOutput, scaleCropToOutput, crop.x * scaleInputToOutput,
+                               crop.y * scaleInputToOutput);
+                // Replace the candidate by the crop person that overlaps it the most
+                auto bestIou = CASCADE_MIN_IOU;
+                auto bestPerson = -1;
+                for (auto person = 0 ; person < cropKeypoints.getSize(0) ; person++)
+                {
+                    const auto iou = getIou(personRectangle, getKeypointsRectangle(&cropKeypoints[person * personVolume],
+                                                                                    mNumberBodyParts, CASCADE_KEYPOINTS_THRESHOLD));
+                    if (iou > bestIou)
+                    {
+                        bestIou = iou;
+                        bestPerson = person;
+                    }
+                }
+                if (bestPerson >= 0)
+                {
+                    const auto* cropPersonPtr = &cropKeypoints[bestPerson * personVolume];
+                    std::copy(cropPersonPtr, cropPersonPtr + personVolume, personPtr);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Array<float> PoseExtractorCascade::getHeatMaps() const
+    {
+        try
+        {
+            // Heat maps of the first (whole frame) stage
+            return mHeatMaps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    Array<float> PoseExtractorCascade::getPoseKeypoints() const
+    {
+        try
+        {
+            return mPoseKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    float PoseExtractorCascade::getScaleNetToOutput() const
+    {
+        try
+        {
+            return mScaleNetToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    cv::Rect PoseExtractorCascade::getCrop(const Rectangle<float>& personRectangle, const Point<int>& frameSize) const
+    {
+        try
+        {
+            // Padded crop with the net input aspect ratio, centered on the person
+            const auto netAspectRatio = mNetInputSize.x / (float)mNetInputSize.y;
+            const auto height = (1.f + 2.f * CASCADE_CROP_PADDING)
+                              * fastMax(personRectangle.height, personRectangle.width / netAspectRatio);
+            const auto width = height * netAspectRatio;
+            const auto cropWidth = fastMin(intRound(width), frameSize.x);
+            const auto cropHeight = fastMin(intRound(height), frameSize.y);
+            // Almost the whole frame -> no upscaling gain
+            if (cropWidth == frameSize.x && cropHeight == frameSize.y)
+                return cv::Rect{};
+            // Shifted inside the frame (rather than cut) to keep the aspect ratio
+            const auto center = personRectangle.center();
+            const auto xMin = fastTruncate(intRound(center.x - cropWidth / 2.f), 0, frameSize.x - cropWidth);
+            const auto yMin = fastTruncate(intRound(center.y - cropHeight / 2.f), 0, frameSize.y - cropHeight);
+            return cv::Rect{xMin, yMin, cropWidth, cropHeight};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Rect{};
+        }
+    }
+}
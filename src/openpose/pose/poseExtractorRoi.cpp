@@ -0,0 +1,162 @@
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/pose/poseExtractorRoi.hpp>
+
+namespace op
+{
+    // Threshold to compute the people rectangles (same one than the hand detector tracking)
+    const auto ROI_KEYPOINTS_THRESHOLD = 0.25f;
+    // If the ROI covers most of the frame, cropping does not pay off
+    const auto ROI_MAX_AREA_RATIO = 0.8f;
+
+    PoseExtractorRoi::PoseExtractorRoi(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize,
+                                       const int scaleNumber, const float scaleGap, const int fullFrameInterval, const float roiPadding) :
+        spPoseExtractor{poseExtractor},
+        mNetInputSize{netInputSize},
+        mFullFrameInterval{fullFrameInterval},
+        mRoiPadding{roiPadding},
+        spCvMatToOpInput{std::make_shared<CvMatToOpInput>(netInputSize, scaleNumber, scaleGap)},
+        mFrameCounter{0ull},
+        mLastFrameCropped{false},
+        mScaleNetToOutput{1.f}
+    {
+        try
+        {
+            if (mFullFrameInterval < 1)
+                error("The full frame interval must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (mRoiPadding < 0.f)
+                error("The ROI padding cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorRoi::initializationOnThread()
+    {
+        try
+        {
+            spPoseExtractor->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorRoi::forwardPass(const GpuArray<float>& inputNetData, const cv::cuda::GpuMat& cvInputData,
+                                       const std::vector<float>& scaleRatios, const float scaleInputToOutput)
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+            const Point<int> frameSize{cvInputData.cols, cvInputData.rows};
+            const auto fullFrame = (mFrameCounter % mFullFrameInterval == 0);
+            const auto roi = (fullFrame ? cv::Rect{} : getPaddedRoi(frameSize));
+            mFrameCounter++;
+
+            // Cropped pass
+            if (roi.area() > 0)
+            {
+                const cv::cuda::GpuMat cvInputDataRoi = cvInputData(roi);
+                const auto roiScaleRatios = spCvMatToOpInput->format(mRoiNetData, cvInputDataRoi);
+                const Point<int> roiSize{roi.width, roi.height};
+                spPoseExtractor->forwardPass(mRoiNetData, roiSize, roiScaleRatios);
+                mPoseKeypoints = spPoseExtractor->getPoseKeypoints();
+                // ROI output coordinates -> frame output coordinates
+                // Keypoints = roiCoordinates * scaleRoiToNet * scaleNetToOutput
+                const auto scaleRoiToNet = (float)resizeGetScaleFactor(roiSize, mNetInputSize);
+                const auto scaleRoiToOutput = scaleInputToOutput / (scaleRoiToNet * spPoseExtractor->getScaleNetToOutput());
+                scaleKeypoints(mPoseKeypoints, scaleRoiToOutput, scaleRoiToOutput, roi.x * scaleInputToOutput, roi.y * scaleInputToOutput);
+                mLastFrameCropped = true;
+            }
+            // Full frame pass
+            else
+            {
+                spPoseExtractor->forwardPass(inputNetData, frameSize, scaleRatios);
+                mPoseKeypoints = spPoseExtractor->getPoseKeypoints();
+                mScaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                mLastFrameCropped = false;
+            }
+
+            // ROI for the next frame (input coordinates)
+            mPreviousRoi = getKeypointsRoi(mPoseKeypoints, ROI_KEYPOINTS_THRESHOLD) / scaleInputToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Array<float> PoseExtractorRoi::getHeatMaps() const
+    {
+        try
+        {
+            // Heat maps of a cropped frame are not aligned with the full frame
+            return (mLastFrameCropped ? Array<float>{} : spPoseExtractor->getHeatMaps());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    Array<float> PoseExtractorRoi::getPoseKeypoints() const
+    {
+        try
+        {
+            return mPoseKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    float PoseExtractorRoi::getScaleNetToOutput() const
+    {
+        try
+        {
+            return mScaleNetToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    cv::Rect PoseExtractorRoi::getPaddedRoi(const Point<int>& frameSize) const
+    {
+        try
+        {
+            // No people in the previous frame -> full frame
+            if (mPreviousRoi.area() <= 0)
+                return cv::Rect{};
+            // Padding (proportional to the ROI size)
+            const auto padding = mRoiPadding * fastMax(mPreviousRoi.width, mPreviousRoi.height);
+            const auto xMin = fastTruncate(intRound(mPreviousRoi.x - padding), 0, frameSize.x);
+            const auto yMin = fastTruncate(intRound(mPreviousRoi.y - padding), 0, frameSize.y);
+            const auto xMax = fastTruncate(intRound(mPreviousRoi.x + mPreviousRoi.width + padding), 0, frameSize.x);
+            const auto yMax = fastTruncate(intRound(mPreviousRoi.y + mPreviousRoi.height + padding), 0, frameSize.y);
+            const cv::Rect roi{xMin, yMin, xMax - xMin, yMax - yMin};
+            // Almost the whole frame -> full frame
+            if (roi.area() > ROI_MAX_AREA_RATIO * frameSize.area())
+                return cv::Rect{};
+            return roi;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Rect{};
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#include <openpose/utilities/cuda.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/pose/poseExtractorTiled.hpp>
+
+namespace op
+{
+    PoseExtractorTiled::PoseExtractorTiled(const std::shared_ptr<PoseExtractor>& poseExtractor, const Point<int>& netInputSize,
+                                           const int scaleNumber, const float scaleGap, const float tileScale, const float tileOverlap) :
+        spPoseExtractor{poseExtractor},
+        mNetInputSize{netInputSize},
+        mTileScale{tileScale},
+        mTileOverlap{tileOverlap},
+        spCvMatToOpInput{std::make_shared<CvMatToOpInput>(netInputSize, scaleNumber, scaleGap)},
+        mScaleNetToOutput{1.f}
+    {
+        try
+        {
+            if (mTileScale <= 0.f)
+                error("The tile scale must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (mTileOverlap < 0.f || mTileOverlap >= 1.f)
+                error("The tile overlap must be in the range [0, 1).", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorTiled::initializationOnThread()
+    {
+        try
+        {
+            spPoseExtractor->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorTiled::forwardPass(const cv::cuda::GpuMat& cvInputData, const float scaleInputToOutput)
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+
+            // All the tiles (and their scales) stacked into a single batch. The tiles have the same size, so the same scales
+            const Point<int> frameSize{cvInputData.cols, cvInputData.rows};
+            const auto tiles = getTiles(frameSize);
+            std::vector<float> tileScaleRatios;
+            for (auto tile = 0u ; tile < tiles.size() ; tile++)
+            {
+                tileScaleRatios = spCvMatToOpInput->format(mTileNetData, cvInputData(tiles[tile]));
+                if (tile == 0)
+                {
+                    auto tilesNetDataSize = mTileNetData.getSize();
+                    tilesNetDataSize[0] *= (int)tiles.size();
+                    if (mTilesNetData.getSize() != tilesNetDataSize)
+                        mTilesNetData.reset(tilesNetDataSize);
+                }
+                const auto tileVolume = mTileNetData.getVolume();
+                cudaMemcpy(mTilesNetData.getPtr() + tile * tileVolume, mTileNetData.getConstPtr(), tileVolume * sizeof(float),
+                           cudaMemcpyDeviceToDevice);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+
+            // Single forward pass. The heat maps and PAFs of the overlapping areas are merged before the peaks are extracted and the
+            // body parts connected, so the people on the seams are found once
+            spPoseExtractor->forwardPassTiles(mTilesNetData, frameSize, tiles, tileScaleRatios);
+
+            // Keypoints = frameNetCoordinates * scaleNetToOutput (frame net coordinates = frame coordinates * scaleTileToNet)
+            const auto scaleTileToNet = (float)resizeGetScaleFactor(Point<int>{tiles[0].width, tiles[0].height}, mNetInputSize);
+            mScaleNetToOutput = scaleInputToOutput / scaleTileToNet;
+            mPoseKeypoints = spPoseExtractor->getPoseKeypoints();
+            scaleKeypoints(mPoseKeypoints, mScaleNetToOutput / spPoseExtractor->getScaleNetToOutput());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Array<float> PoseExtractorTiled::getPoseKeypoints() const
+    {
+        try
+        {
+            return mPoseKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    float PoseExtractorTiled::getScaleNetToOutput() const
+    {
+        try
+        {
+            return mScaleNetToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    std::vector<cv::Rect> PoseExtractorTiled::getTiles(const Point<int>& frameSize) const
+    {
+        try
+        {
+            // Tile size in input pixels (a net input at mTileScale), never bigger than the frame
+            const Point<int> tileSize{fastMin(intRound(mNetInputSize.x / mTileScale), frameSize.x),
+                                      fastMin(intRound(mNetInputSize.y / mTileScale), frameSize.y)};
+            // Number of tiles per dimension so consecutive tiles overlap at least mTileOverlap
+            const auto getTileNumber = [&](const int frameLength, const int tileLength)
+            {
+                if (tileLength >= frameLength)
+                    return 1;
+                const auto step = fastMax(1, intRound(tileLength * (1.f - mTileOverlap)));
+                return 1 + (frameLength - tileLength + step - 1) / step;
+            };
+            const auto tilesX = getTileNumber(frameSize.x, tileSize.x);
+            const auto tilesY = getTileNumber(frameSize.y, tileSize.y);
+            // Tiles evenly distributed, the last one aligned with the frame border
+            std::vector<cv::Rect> tiles;
+            tiles.reserve(tilesX * tilesY);
+            for (auto y = 0 ; y < tilesY ; y++)
+            {
+                const auto yMin = (tilesY > 1 ? intRound(y * (frameSize.y - tileSize.y) / float(tilesY - 1)) : 0);
+                for (auto x = 0 ; x < tilesX ; x++)
+                {
+                    const auto xMin = (tilesX > 1 ? intRound(x * (frameSize.x - tileSize.x) / float(tilesX - 1)) : 0);
+                    tiles.emplace_back(xMin, yMin, tileSize.x, tileSize.y);
+                }
+            }
+            return tiles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -266,12 +266,14 @@ namespace op
 			{
 				if (scaleNetToOutput == -1.f)
 					error("Non valid scaleNetToOutput.", __LINE__, __FUNCTION__, __FILE__);
+				// Current one (the net input resolution might change at runtime)
+				const auto heatMapsSize = spPoseExtractor->getNetOutputSize();
 				// Draw specific body part or bkg
 				if (elementRendered <= numberBodyPartsPlusBkg)
 				{
 					elementRenderedName = mPartIndexToName.at(elementRendered - 1);
 					renderPoseHeatMapGpu(*spGpuMemoryPtr, mPoseModel, mOutputSize, spPoseExtractor->getHeatMapCpuConstPtr(),
-						mHeatMapsSize, scaleNetToOutput, elementRendered,
+						heatMapsSize, scaleNetToOutput, elementRendered,
 						(mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
 				}
 				// Draw PAFs (Part Affinity Fields)
@@ -279,14 +281,14 @@ namespace op
 				{
 					elementRenderedName = "Heatmaps";
 					renderPoseHeatMapsGpu(*spGpuMemoryPtr, mPoseModel, mOutputSize, spPoseExtractor->getHeatMapCpuConstPtr(),
-						mHeatMapsSize, scaleNetToOutput, (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+						heatMapsSize, scaleNetToOutput, (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
 				}
 				// Draw PAFs (Part Affinity Fields)
 				else if (elementRendered == numberBodyPartsPlusBkg + 2)
 				{
 					elementRenderedName = "PAFs (Part Affinity Fields)";
 					renderPosePAFsGpu(*spGpuMemoryPtr, mPoseModel, mOutputSize, spPoseExtractor->getHeatMapCpuConstPtr(),
-						mHeatMapsSize, scaleNetToOutput, (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+						heatMapsSize, scaleNetToOutput, (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
 				}
 				// Draw affinity between 2 body parts
 				else
@@ -296,7 +298,7 @@ namespace op
 					elementRenderedName = mPartIndexToName.at(affinityPartMapped);
 					elementRenderedName = elementRenderedName.substr(0, elementRenderedName.find("("));
 					renderPosePAFGpu(*spGpuMemoryPtr, mPoseModel, mOutputSize, spPoseExtractor->getHeatMapCpuConstPtr(),
-						mHeatMapsSize, scaleNetToOutput, affinityPartMapped,
+						heatMapsSize, scaleNetToOutput, affinityPartMapped,
 						(mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
 				}
 			}
@@ -0,0 +1,159 @@
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+#include <opencv2/video/tracking.hpp> // cv::calcOpticalFlowPyrLK
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/pose/poseTracker.hpp>
+
+namespace op
+{
+    PoseTracker::PoseTracker(const int keyframeInterval, const float minTrackedRatio, const float maxTrackingError) :
+        mKeyframeInterval{keyframeInterval},
+        mMinTrackedRatio{minTrackedRatio},
+        mMaxTrackingError{maxTrackingError},
+        mFramesSinceKeyframe{0},
+        mTrackingLost{true}
+    {
+        try
+        {
+            if (mKeyframeInterval < 1)
+                error("The keyframe interval must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            if (mMinTrackedRatio < 0.f || mMinTrackedRatio > 1.f)
+                error("The minimum tracked ratio must be in the range [0, 1].", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseTracker::isKeyframeRequired() const
+    {
+        try
+        {
+            return (mTrackingLost || mPreviousGray.empty() || mFramesSinceKeyframe + 1 >= mKeyframeInterval);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    void PoseTracker::setKeyframe(const cv::Mat& cvInputData, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            setPrevious(cvInputData, poseKeypoints);
+            mFramesSinceKeyframe = 0;
+            mTrackingLost = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseTracker::track(Array<float>& poseKeypoints, const cv::Mat& cvInputData, const float scaleInputToOutput)
+    {
+        try
+        {
+            // Security checks
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+            if (mPreviousGray.empty())
+            {
+                mTrackingLost = true;
+                return false;
+            }
+
+            // Nobody to track
+            if (mPreviousKeypoints.empty())
+            {
+                poseKeypoints.reset();
+                cv::cvtColor(cvInputData, mPreviousGray, cv::COLOR_BGR2GRAY);
+                mFramesSinceKeyframe++;
+                return true;
+            }
+
+            // Previous keypoints (output resolution) -> cvInputData coordinates
+            const auto numberKeypoints = mPreviousKeypoints.getSize(0) * mPreviousKeypoints.getSize(1);
+            const auto scaleOutputToInput = 1.f / scaleInputToOutput;
+            mPreviousPoints.clear();
+            mPointIndexes.clear();
+            for (auto keypoint = 0 ; keypoint < numberKeypoints ; keypoint++)
+            {
+                const auto baseIndex = 3*keypoint;
+                if (mPreviousKeypoints[baseIndex+2] > 0.f)
+                {
+                    mPreviousPoints.emplace_back(cv::Point2f{mPreviousKeypoints[baseIndex] * scaleOutputToInput,
+                                                             mPreviousKeypoints[baseIndex+1] * scaleOutputToInput});
+                    mPointIndexes.emplace_back(keypoint);
+                }
+            }
+
+            cv::Mat currentGray;
+            cv::cvtColor(cvInputData, currentGray, cv::COLOR_BGR2GRAY);
+
+            // Sparse optical flow
+            auto numberTracked = 0;
+            auto trackedKeypoints = mPreviousKeypoints.clone();
+            if (!mPreviousPoints.empty())
+            {
+                std::vector<unsigned char> status;
+                std::vector<float> errors;
+                cv::calcOpticalFlowPyrLK(mPreviousGray, currentGray, mPreviousPoints, mCurrentPoints, status, errors,
+                                         cv::Size{21,21}, 3);
+                for (auto i = 0u ; i < mPointIndexes.size() ; i++)
+                {
+                    const auto baseIndex = 3*mPointIndexes[i];
+                    if (status[i] && errors[i] < mMaxTrackingError)
+                    {
+                        trackedKeypoints[baseIndex] = mCurrentPoints[i].x * scaleInputToOutput;
+                        trackedKeypoints[baseIndex+1] = mCurrentPoints[i].y * scaleInputToOutput;
+                        numberTracked++;
+                    }
+                    // Lost keypoint
+                    else
+                    {
+                        trackedKeypoints[baseIndex] = 0.f;
+                        trackedKeypoints[baseIndex+1] = 0.f;
+                        trackedKeypoints[baseIndex+2] = 0.f;
+                    }
+                }
+            }
+
+            // Tracking failure -> keyframe required
+            if (mPreviousPoints.empty() || numberTracked < mMinTrackedRatio * mPreviousPoints.size())
+            {
+                mTrackingLost = true;
+                return false;
+            }
+
+            // Tracking success
+            poseKeypoints = trackedKeypoints;
+            mPreviousGray = currentGray;
+            mPreviousKeypoints = trackedKeypoints;
+            mFramesSinceKeyframe++;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void PoseTracker::setPrevious(const cv::Mat& cvInputData, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+            cv::cvtColor(cvInputData, mPreviousGray, cv::COLOR_BGR2GRAY);
+            mPreviousKeypoints = poseKeypoints.clone();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
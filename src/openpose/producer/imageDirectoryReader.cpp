@@ -28,12 +28,54 @@ namespace op
         }
     }
 
-    ImageDirectoryReader::ImageDirectoryReader(const std::string& imageDirectoryPath) :
+    ImageDirectoryReader::ImageDirectoryReader(const std::string& imageDirectoryPath, const int readAheadImages,
+                                               const int decodingThreads) :
         Producer{ProducerType::ImageDirectory},
         mImageDirectoryPath{imageDirectoryPath},
         mFilePaths{getImagePathsOnDirectory(imageDirectoryPath)},
-        mFrameNameCounter{0}
+        mFrameNameCounter{0},
+        mFrameScale{1.},
+        mDecodingThreads{decodingThreads},
+        mNextFrameToRead{0},
+        mReadAheadGeneration{0},
+        mReadAheadStalls{0},
+        mCloseThreads{false}
     {
+        try
+        {
+            if (readAheadImages < 0 || (readAheadImages > 0 && decodingThreads < 1))
+                error("The number of read-ahead images must be non-negative and, if positive, the number of decoding threads must be"
+                      " positive.", __LINE__, __FUNCTION__, __FILE__);
+            // The threads are started with the first frame (i.e. after setReducedDecoding)
+            mReadAheadImages.resize(readAheadImages, ReadAheadImage{-1ll, ReadAheadState::Free, {}, cv::Mat{}, 1.});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ImageDirectoryReader::~ImageDirectoryReader()
+    {
+        try
+        {
+            // Close and join threads
+            {
+                const std::lock_guard<std::mutex> lock{mReadAheadMutex};
+                mCloseThreads = true;
+            }
+            mReadAheadConditionVariable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+            if (!mThreads.empty())
+                log("Image read-ahead: the producer waited for the decoding on " + std::to_string(mReadAheadStalls.load()) + " frame(s).",
+                    Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::string ImageDirectoryReader::getFrameName()
@@ -41,15 +83,32 @@ namespace op
         return getFileNameNoExtension(mFilePaths.at(mFrameNameCounter));
     }
 
+    void ImageDirectoryReader::setReducedDecoding(const std::vector<Point<int>>& targetResolutions)
+    {
+        try
+        {
+            mTargetResolutions = {targetResolutions};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     cv::Mat ImageDirectoryReader::getRawFrame()
     {
         try
         {
-            auto frame = loadImage(mFilePaths.at(mFrameNameCounter++).c_str(), CV_LOAD_IMAGE_COLOR);
+            mFrameScale = 1.;
+            auto frame = (!mReadAheadImages.empty()
+                ? getReadAheadFrame()
+                : mTargetResolutions.empty()
+                ? loadImage(mFilePaths.at(mFrameNameCounter++).c_str(), CV_LOAD_IMAGE_COLOR)
+                : loadImageReduced(mFrameScale, mFilePaths.at(mFrameNameCounter++), mTargetResolutions));
             // Check frame integrity. This function also checks width/height changes. However, if it is performed after setWidth/setHeight this is performed over the new resolution (so they always match).
             checkFrameIntegrity(frame);
-            // Update size, since images might have different size between each one of them
-            mResolution = Point<int>{frame.cols, frame.rows};
+            // Update size, since images might have different size between each one of them (original image size if reduced)
+            mResolution = Point<int>{intRound(frame.cols / mFrameScale), intRound(frame.rows / mFrameScale)};
             return frame;
         }
         catch (const std::exception& e)
@@ -105,7 +164,12 @@ namespace op
             else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
                 mResolution.y = {(int)value};
             else if (capProperty == CV_CAP_PROP_POS_FRAMES)
-                mFrameNameCounter = fastTruncate((long long)value, 0ll, (long long)mImageDirectoryPath.size()-1);
+            {
+                mFrameNameCounter = fastTruncate((long long)value, 0ll, (long long)mFilePaths.size()-1);
+                // The read-ahead images are no longer the following ones
+                if (!mReadAheadImages.empty())
+                    flushReadAhead();
+            }
             else if (capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
                 log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
             else
@@ -116,4 +180,163 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    cv::Mat ImageDirectoryReader::getReadAheadFrame()
+    {
+        try
+        {
+            // Start reading and decoding threads
+            if (mThreads.empty())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mReadAheadMutex};
+                    mNextFrameToRead = mFrameNameCounter;
+                }
+                mThreads.emplace_back(&ImageDirectoryReader::readingThread, this);
+                for (auto i = 0; i < mDecodingThreads; i++)
+                    mThreads.emplace_back(&ImageDirectoryReader::decodingThread, this);
+            }
+            const auto frameIndex = mFrameNameCounter++;
+            if (frameIndex < 0 || frameIndex >= (long long)mFilePaths.size())
+                error("Frame index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            // Wait for the frame (in order)
+            std::unique_lock<std::mutex> lock{mReadAheadMutex};
+            auto& readAheadImage = mReadAheadImages[frameIndex % mReadAheadImages.size()];
+            const auto frameDecoded = [&]
+            {
+                return readAheadImage.frameIndex == frameIndex && readAheadImage.state == ReadAheadState::Decoded;
+            };
+            if (!frameDecoded())
+            {
+                mReadAheadStalls++;
+                mReadAheadConditionVariable.wait(lock, [&]{ return frameDecoded() || mCloseThreads; });
+            }
+            // Release its slot for the reading thread
+            cv::Mat frame;
+            std::swap(frame, readAheadImage.frame);
+            mFrameScale = readAheadImage.frameScale;
+            readAheadImage.frameIndex = -1;
+            readAheadImage.state = ReadAheadState::Free;
+            lock.unlock();
+            mReadAheadConditionVariable.notify_all();
+            return frame;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
+
+    void ImageDirectoryReader::flushReadAhead()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mReadAheadMutex};
+                mReadAheadGeneration++;
+                for (auto& readAheadImage : mReadAheadImages)
+                {
+                    readAheadImage.frameIndex = -1;
+                    readAheadImage.state = ReadAheadState::Free;
+                    readAheadImage.encodedImage.clear();
+                    readAheadImage.frame = cv::Mat{};
+                }
+                mNextFrameToRead = mFrameNameCounter;
+            }
+            mReadAheadConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ImageDirectoryReader::readingThread()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mReadAheadMutex};
+            while (!mCloseThreads)
+            {
+                // Wait until the slot of the next file is free (i.e. at most readAheadImages images ahead)
+                mReadAheadConditionVariable.wait(lock, [&]
+                {
+                    return mCloseThreads || (mNextFrameToRead < (long long)mFilePaths.size()
+                                             && mReadAheadImages[mNextFrameToRead % mReadAheadImages.size()].state
+                                                == ReadAheadState::Free);
+                });
+                if (mCloseThreads)
+                    break;
+                const auto frameIndex = mNextFrameToRead++;
+                const auto generation = mReadAheadGeneration;
+                auto& readAheadImage = mReadAheadImages[frameIndex % mReadAheadImages.size()];
+                readAheadImage.frameIndex = frameIndex;
+                readAheadImage.state = ReadAheadState::Reading;
+                // Read file (overlapped with the decoding of the previous ones)
+                lock.unlock();
+                auto encodedImage = loadEncodedImage(mFilePaths[frameIndex]);
+                lock.lock();
+                // Discarded if flushed meanwhile
+                if (generation == mReadAheadGeneration)
+                {
+                    std::swap(readAheadImage.encodedImage, encodedImage);
+                    readAheadImage.state = ReadAheadState::Read;
+                    mReadAheadConditionVariable.notify_all();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ImageDirectoryReader::decodingThread()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mReadAheadMutex};
+            while (!mCloseThreads)
+            {
+                // Earliest read image, so the frame getFrame waits for is decoded first
+                ReadAheadImage* readAheadImage = nullptr;
+                mReadAheadConditionVariable.wait(lock, [&]
+                {
+                    readAheadImage = nullptr;
+                    for (auto& image : mReadAheadImages)
+                        if (image.state == ReadAheadState::Read
+                            && (readAheadImage == nullptr || image.frameIndex < readAheadImage->frameIndex))
+                            readAheadImage = &image;
+                    return mCloseThreads || readAheadImage != nullptr;
+                });
+                if (mCloseThreads)
+                    break;
+                const auto frameIndex = readAheadImage->frameIndex;
+                const auto generation = mReadAheadGeneration;
+                std::vector<unsigned char> encodedImage;
+                std::swap(encodedImage, readAheadImage->encodedImage);
+                readAheadImage->state = ReadAheadState::Decoding;
+                // Decode
+                lock.unlock();
+                auto frameScale = 1.;
+                auto frame = decodeImageReduced(frameScale, encodedImage, mTargetResolutions);
+                if (frame.empty())
+                    log("Empty image on path: " + mFilePaths[frameIndex] + ".", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                lock.lock();
+                // Discarded if flushed meanwhile
+                if (generation == mReadAheadGeneration)
+                {
+                    std::swap(readAheadImage->frame, frame);
+                    readAheadImage->frameScale = frameScale;
+                    readAheadImage->state = ReadAheadState::Decoded;
+                    mReadAheadConditionVariable.notify_all();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
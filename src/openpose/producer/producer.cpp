@@ -34,7 +34,7 @@ namespace op
 
     Producer::~Producer(){}
 
-    cv::Mat Producer::getFrame()
+    cv::Mat Producer::getFrame(const bool flipAndRotateFrame)
     {
         try
         {
@@ -47,9 +47,10 @@ namespace op
                 // Get frame
                 frame = getRawFrame();
                 // Flip + rotate frame
-                flipAndRotate(frame);
+                if (flipAndRotateFrame)
+                    flipAndRotate(frame);
                 // Check frame integrity
-                checkFrameIntegrity(frame);
+                checkFrameIntegrity(frame, flipAndRotateFrame);
                 // Check if video capture did finish and close/restart it
                 ifEndedResetOrRelease();
             }
@@ -137,7 +138,7 @@ namespace op
         }
     }
 
-    void Producer::checkFrameIntegrity(cv::Mat& frame)
+    void Producer::checkFrameIntegrity(cv::Mat& frame, const bool flippedAndRotated)
     {
         try
         {
@@ -153,7 +154,12 @@ namespace op
             {
                 mNumberEmptyFrames = 0;
 
-                if (mType != ProducerType::ImageDirectory && (frame.cols != get(CV_CAP_PROP_FRAME_WIDTH) || frame.rows != get(CV_CAP_PROP_FRAME_HEIGHT)))
+                // get(CV_CAP_PROP_FRAME_WIDTH/HEIGHT) give the rotated resolution
+                const auto rotationAngle = mProperties[(unsigned char)ProducerProperty::Rotation];
+                const auto transposed = (!flippedAndRotated && (rotationAngle == 90. || rotationAngle == 270.));
+                const auto width = (transposed ? frame.rows : frame.cols);
+                const auto height = (transposed ? frame.cols : frame.rows);
+                if (mType != ProducerType::ImageDirectory && (width != get(CV_CAP_PROP_FRAME_WIDTH) || height != get(CV_CAP_PROP_FRAME_HEIGHT)))
                 {
                     log("Frame size changed. Returning empty frame.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
                     frame = cv::Mat{};
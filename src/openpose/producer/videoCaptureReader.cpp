@@ -69,7 +69,7 @@ namespace op
         try
         {
             cv::Mat frame;
-            mVideoCapture >> frame;
+            retrieveFrame(frame);
             return frame;
         }
         catch (const std::exception& e)
@@ -79,6 +79,19 @@ namespace op
         }
     }
 
+    void VideoCaptureReader::retrieveFrame(cv::Mat& frame)
+    {
+        try
+        {
+            // cv::VideoCapture::read releases frame if there are no more frames
+            mVideoCapture.read(frame);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void VideoCaptureReader::release()
     {
         try
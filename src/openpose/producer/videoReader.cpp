@@ -1,13 +1,51 @@
 #include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/producer/videoReader.hpp>
 
 namespace op
 {
-    VideoReader::VideoReader(const std::string & videoPath) :
+    VideoReader::VideoReader(const std::string & videoPath, const int prefetchFrames) :
         VideoCaptureReader{videoPath},
-        mPathName{getFileNameNoExtension(videoPath)}
+        mPathName{getFileNameNoExtension(videoPath)},
+        mFirstFrame{0u},
+        mNumberFrames{0u},
+        mEndOfVideo{false},
+        mFrameCounter{0},
+        mCloseThread{false}
     {
+        try
+        {
+            if (prefetchFrames < 0)
+                error("The number of prefetched frames must be non-negative.", __LINE__, __FUNCTION__, __FILE__);
+            // Constant for a video file (read here so get() does not wait for the buffering thread decoding)
+            mFrameCount = VideoCaptureReader::get(CV_CAP_PROP_FRAME_COUNT);
+            mFps = VideoCaptureReader::get(CV_CAP_PROP_FPS);
+            // Unrotated resolution (no rotation is set yet), get() applies the rotation swap
+            mWidth = VideoCaptureReader::get(CV_CAP_PROP_FRAME_WIDTH);
+            mHeight = VideoCaptureReader::get(CV_CAP_PROP_FRAME_HEIGHT);
+            // Preallocated frames (the buffering thread is started with the first frame, i.e. after the initial seek)
+            const auto width = intRound(mWidth);
+            const auto height = intRound(mHeight);
+            for (auto i = 0; i < prefetchFrames; i++)
+                mFrames.emplace_back(height, width, CV_8UC3);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    VideoReader::~VideoReader()
+    {
+        try
+        {
+            closeThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::string VideoReader::getFrameName()
@@ -23,11 +61,112 @@ namespace op
         }
     }
 
+    void VideoReader::release()
+    {
+        try
+        {
+            // The buffering thread must not decode from a released cv::VideoCapture
+            closeThread();
+            VideoCaptureReader::release();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    double VideoReader::get(const int capProperty)
+    {
+        try
+        {
+            if (mFrames.empty())
+                return VideoCaptureReader::get(capProperty);
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+            {
+                const std::lock_guard<std::mutex> lock{mFramesMutex};
+                return (double)mFrameCounter;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return mFrameCount;
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return mFps;
+            // Read every frame by the integrity check, so they must not wait for the frame being decoded
+            else if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                // Same swap as VideoCaptureReader::get for 90 and 270 degree rotations
+                const auto rotation = VideoCaptureReader::get(ProducerProperty::Rotation);
+                const auto swapped = (rotation != 0. && rotation != 180.);
+                return ((capProperty == CV_CAP_PROP_FRAME_WIDTH) != swapped ? mWidth : mHeight);
+            }
+            else
+            {
+                const std::lock_guard<std::mutex> captureLock{mCaptureMutex};
+                return VideoCaptureReader::get(capProperty);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void VideoReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            if (mFrames.empty())
+                VideoCaptureReader::set(capProperty, value);
+            else
+            {
+                const std::lock_guard<std::mutex> captureLock{mCaptureMutex};
+                VideoCaptureReader::set(capProperty, value);
+                // Seek: the buffered frames are no longer the following ones
+                if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock{mFramesMutex};
+                        mFirstFrame = 0u;
+                        mNumberFrames = 0u;
+                        mEndOfVideo = false;
+                        mFrameCounter = longLongRound(VideoCaptureReader::get(CV_CAP_PROP_POS_FRAMES));
+                    }
+                    mFramesConditionVariable.notify_all();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     cv::Mat VideoReader::getRawFrame()
     {
         try
         {
-            return VideoCaptureReader::getRawFrame();
+            if (mFrames.empty())
+                return VideoCaptureReader::getRawFrame();
+
+            // Start buffering thread
+            if (!mThread.joinable() && !mCloseThread)
+                mThread = std::thread{&VideoReader::bufferingThread, this};
+
+            // Retrieve frame from ring buffer (empty if the video ended)
+            cv::Mat cvMat;
+            std::unique_lock<std::mutex> lock{mFramesMutex};
+            mFramesConditionVariable.wait(lock, [&]{ return mNumberFrames > 0u || mEndOfVideo || mCloseThread; });
+            if (mNumberFrames > 0u)
+            {
+                // Shallow copy, its buffer is reused once no Datum references it
+                cvMat = mFrames[mFirstFrame];
+                mFirstFrame = (mFirstFrame + 1u) % mFrames.size();
+                mNumberFrames--;
+            }
+            mFrameCounter++;
+            lock.unlock();
+            mFramesConditionVariable.notify_all();
+            return cvMat;
         }
         catch (const std::exception& e)
         {
@@ -35,4 +174,63 @@ namespace op
             return cv::Mat{};
         }
     }
+
+    void VideoReader::closeThread()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mFramesMutex};
+                mCloseThread = true;
+            }
+            mFramesConditionVariable.notify_all();
+            if (mThread.joinable())
+                mThread.join();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void VideoReader::bufferingThread()
+    {
+        try
+        {
+            while (!mCloseThread)
+            {
+                // Wait for a free slot
+                std::unique_lock<std::mutex> lock{mFramesMutex};
+                mFramesConditionVariable.wait(lock, [&]
+                {
+                    return mCloseThread || (!mEndOfVideo && mNumberFrames < mFrames.size());
+                });
+                if (mCloseThread)
+                    break;
+                lock.unlock();
+                // Seeks also lock mCaptureMutex, so the ring buffer cannot be flushed while decoding
+                const std::lock_guard<std::mutex> captureLock{mCaptureMutex};
+                lock.lock();
+                if (mEndOfVideo || mNumberFrames == mFrames.size())
+                    continue;
+                auto& frame = mFrames[(mFirstFrame + mNumberFrames) % mFrames.size()];
+                lock.unlock();
+                // Decode into the preallocated frame, unless a previous Datum still references it
+                if (frame.u != nullptr && frame.u->refcount > 1)
+                    frame = cv::Mat{};
+                retrieveFrame(frame);
+                lock.lock();
+                if (frame.empty())
+                    mEndOfVideo = true;
+                else
+                    mNumberFrames++;
+                lock.unlock();
+                mFramesConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -70,7 +70,7 @@ namespace op
     {
         try
         {
-            if (scaleX != 1. && scaleY != 1.)
+            if (scaleX != 1. || scaleY != 1. || offsetX != 0. || offsetY != 0.)
             {
                 // Error check
                 if (!keypoints.empty() && keypoints.getSize(2) != 3)
@@ -243,6 +243,42 @@ namespace op
         }
     }
 
+    Rectangle<float> getKeypointsRoi(const Array<float>& keypoints, const float threshold)
+    {
+        try
+        {
+            if (!keypoints.empty())
+            {
+                const auto numberPeople = keypoints.getSize(0);
+                const auto numberKeypoints = keypoints.getSize(1);
+                const auto area = numberKeypoints * keypoints.getSize(2);
+                auto minX = std::numeric_limits<float>::max();
+                auto minY = minX;
+                auto maxX = -1.f;
+                auto maxY = -1.f;
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    const auto personRectangle = getKeypointsRectangle(&keypoints[person*area], numberKeypoints, threshold);
+                    if (personRectangle.area() > 0)
+                    {
+                        minX = fastMin(minX, personRectangle.x);
+                        minY = fastMin(minY, personRectangle.y);
+                        maxX = fastMax(maxX, personRectangle.x + personRectangle.width);
+                        maxY = fastMax(maxY, personRectangle.y + personRectangle.height);
+                    }
+                }
+                if (maxX >= minX && maxY >= minY)
+                    return Rectangle<float>{minX, minY, maxX-minX, maxY-minY};
+            }
+            return Rectangle<float>{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<float>{};
+        }
+    }
+
     int getBiggestPerson(const Array<float>& keypoints, const float threshold)
     {
         try
@@ -274,4 +310,24 @@ namespace op
             return -1;
         }
     }
+
+    float getIou(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB)
+    {
+        try
+        {
+            const auto xMin = fastMax(rectangleA.x, rectangleB.x);
+            const auto yMin = fastMax(rectangleA.y, rectangleB.y);
+            const auto xMax = fastMin(rectangleA.x + rectangleA.width, rectangleB.x + rectangleB.width);
+            const auto yMax = fastMin(rectangleA.y + rectangleA.height, rectangleB.y + rectangleB.height);
+            if (xMax <= xMin || yMax <= yMin)
+                return 0.f;
+            const auto intersection = (xMax - xMin) * (yMax - yMin);
+            return intersection / (rectangleA.area() + rectangleB.area() - intersection);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
 }
@@ -1,10 +1,145 @@
+#include <cmath> // std::ceil, std::floor
+#include <opencv2/core/hal/intrin.hpp> // CV_SIMD128, cv::v_load_deinterleave
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 
 namespace op
 {
-	
+    // Images with at least this area are converted in parallel (cv::parallel_for_ over rows), smaller ones (e.g. face and hand crops) in
+    // the calling thread
+    const auto PARALLEL_CONVERSION_MIN_AREA = 512*512;
+
+    inline void uCharCvMatRowsToFloatPtr(float* floatImage, const cv::Mat& cvImage, const bool normalize, const int rowBegin,
+                                         const int rowEnd)
+    {
+        try
+        {
+            // Single pass over the interleaved rows, each pixel is written into all the channel planes at once
+            const auto width = cvImage.cols;
+            const auto channels = cvImage.channels();
+            const auto area = width * cvImage.rows;
+            // Normalization: x/256 - 0.5 (exact in float, so identical to dividing)
+            const auto scale = (normalize ? 1.f/256.f : 1.f);
+            const auto shift = (normalize ? -0.5f : 0.f);
+            for (auto y = rowBegin ; y < rowEnd ; y++)
+            {
+                const auto* const sourceRow = cvImage.ptr<uchar>(y);
+                auto* const targetRow = floatImage + y * width;
+                auto x = 0;
+#if CV_SIMD128
+                // 16 BGR pixels per iteration: de-interleave, widen to 32 bits, convert, normalize and store into the 3 planes
+                if (channels == 3)
+                {
+                    const auto scaleVector = cv::v_setall_f32(scale);
+                    const auto shiftVector = cv::v_setall_f32(shift);
+                    for ( ; x <= width - 16 ; x += 16)
+                    {
+                        cv::v_uint8x16 planes[3];
+                        cv::v_load_deinterleave(sourceRow + 3*x, planes[0], planes[1], planes[2]);
+                        for (auto c = 0 ; c < 3 ; c++)
+                        {
+                            cv::v_uint16x8 halves[2];
+                            cv::v_expand(planes[c], halves[0], halves[1]);
+                            for (auto half = 0 ; half < 2 ; half++)
+                            {
+                                cv::v_uint32x4 quarters[2];
+                                cv::v_expand(halves[half], quarters[0], quarters[1]);
+                                for (auto quarter = 0 ; quarter < 2 ; quarter++)
+                                    cv::v_store(targetRow + c*area + x + 8*half + 4*quarter,
+                                                cv::v_cvt_f32(cv::v_reinterpret_as_s32(quarters[quarter])) * scaleVector + shiftVector);
+                            }
+                        }
+                    }
+                }
+#endif
+                // Remaining pixels (or any number of channels)
+                for ( ; x < width ; x++)
+                    for (auto c = 0 ; c < channels ; c++)
+                        targetRow[c*area + x] = float(sourceRow[x*channels + c]) * scale + shift;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+#if CV_SIMD128
+    // 16 floats -> 16 uchars, rounded as intRound (floor(x + 0.5)) and saturated to [0, 255] as fastTruncate
+    inline cv::v_uint8x16 floatToUCharVector(const float* const floatPtr)
+    {
+        const auto half = cv::v_setall_f32(0.5f);
+        const auto low = cv::v_pack(cv::v_floor(cv::v_load(floatPtr) + half), cv::v_floor(cv::v_load(floatPtr + 4) + half));
+        const auto high = cv::v_pack(cv::v_floor(cv::v_load(floatPtr + 8) + half), cv::v_floor(cv::v_load(floatPtr + 12) + half));
+        return cv::v_pack_u(low, high);
+    }
+#endif
+
+    inline void floatPtrRowsToUCharCvMat(cv::Mat& cvMat, const float* const floatImage, const Point<int>& resolutionSize,
+                                         const int resolutionChannels, const int cvMatOffsetX, const int rowBegin, const int rowEnd)
+    {
+        try
+        {
+            // Each output row is written once, reading the same row of all the channel planes
+            const auto width = resolutionSize.x;
+            const auto area = resolutionSize.area();
+            for (auto y = rowBegin ; y < rowEnd ; y++)
+            {
+                auto* const targetRow = cvMat.ptr<uchar>(y) + cvMatOffsetX * resolutionChannels;
+                const auto* const sourceRow = floatImage + y * width;
+                auto x = 0;
+#if CV_SIMD128
+                // 16 pixels per iteration: round, saturate and interleave the 3 planes
+                if (resolutionChannels == 3)
+                {
+                    for ( ; x <= width - 16 ; x += 16)
+                        cv::v_store_interleave(targetRow + 3*x, floatToUCharVector(sourceRow + x),
+                                               floatToUCharVector(sourceRow + area + x), floatToUCharVector(sourceRow + 2*area + x));
+                }
+#endif
+                // Remaining pixels (or any number of channels)
+                for ( ; x < width ; x++)
+                    for (auto c = 0 ; c < resolutionChannels ; c++)
+                        targetRow[x*resolutionChannels + c] = uchar(fastTruncate(intRound(sourceRow[c*area + x]), 0, 255));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    inline void unrollArrayRowsToUCharCvMat(cv::Mat& cvMatResult, const float* const arrayPtr, const int channels, const int width,
+                                            const int height, const int rowBegin, const int rowEnd)
+    {
+        try
+        {
+            // Each output row is the concatenation of the same row of all the channels
+            const auto areaInput = height * width;
+            for (auto y = rowBegin ; y < rowEnd ; y++)
+            {
+                auto* const cvMatRowPtr = cvMatResult.ptr<uchar>(y);
+                for (auto channel = 0 ; channel < channels ; channel++)
+                {
+                    auto* const targetPtr = cvMatRowPtr + channel * width;
+                    const auto* const sourcePtr = arrayPtr + channel * areaInput + y * width;
+                    auto x = 0;
+#if CV_SIMD128
+                    for ( ; x <= width - 16 ; x += 16)
+                        cv::v_store(targetPtr + x, floatToUCharVector(sourcePtr + x));
+#endif
+                    for ( ; x < width ; x++)
+                        targetPtr[x] = uchar(fastTruncate(intRound(sourcePtr[x]), 0, 255));
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void putTextOnCvMat(cv::Mat& cvMat, const std::string& textToDisplay, const Point<int>& position, const cv::Scalar& color, const bool normalizeWidth)
     {
         try
@@ -34,20 +169,14 @@ namespace op
             // cv::Mat (OpenCV format): H x W x C
             if (cvMat.rows != resolutionSize.y || cvMat.cols != resolutionSize.x || cvMat.type() != CV_8UC3)
                 cvMat = cv::Mat(resolutionSize.y, resolutionSize.x, CV_8UC3);
-            const auto offsetBetweenChannels = resolutionSize.x * resolutionSize.y;
-            for (auto c = 0; c < resolutionChannels; c++)
-            {
-                const auto offsetChannelC = c*offsetBetweenChannels;
-                for (auto y = 0; y < resolutionSize.y; y++)
+            // cvMatOffsetY is a column offset
+            if (resolutionSize.area() < PARALLEL_CONVERSION_MIN_AREA)
+                floatPtrRowsToUCharCvMat(cvMat, floatImage, resolutionSize, resolutionChannels, cvMatOffsetY, 0, resolutionSize.y);
+            else
+                cv::parallel_for_(cv::Range{0, resolutionSize.y}, [&](const cv::Range& rows)
                 {
-                    const auto floatImageOffsetY = offsetChannelC + y*resolutionSize.x;
-					for (auto x = 0; x < resolutionSize.x; x++)
-					{
-						const auto value = uchar(fastTruncate(intRound(floatImage[floatImageOffsetY + x]), 0, 255));
-						*(cvMat.ptr<uchar>(y) + (cvMatOffsetY + x)*resolutionChannels + c) = value;
-					}
-                }
-            }
+                    floatPtrRowsToUCharCvMat(cvMat, floatImage, resolutionSize, resolutionChannels, cvMatOffsetY, rows.start, rows.end);
+                });
         }
         catch (const std::exception& e)
         {
@@ -76,7 +205,6 @@ namespace op
                 const auto channels = array.getSize(0);
                 const auto height = array.getSize(1);
                 const auto width = array.getSize(2);
-                const auto areaInput = height * width;
                 const auto areaOutput = channels * width;
 
                 // Allocate cv::Mat
@@ -84,24 +212,14 @@ namespace op
                     cvMatResult = cv::Mat{height, areaOutput, CV_8UC1};
 
                 // Fill cv::Mat
-                for (auto channel = 0 ; channel < channels ; channel++)
-                {
-                    // Get memory to be modified
-                    cv::Mat cvMatROI{cvMatResult, cv::Rect{channel * width, 0, width, height}};
-
-                    // Modify memory
-                    const auto* arrayPtr = array.getConstPtr() + channel * areaInput;
-                    for (auto y = 0 ; y < height ; y++)
+                const auto* const arrayPtr = array.getConstPtr();
+                if (areaOutput * height < PARALLEL_CONVERSION_MIN_AREA)
+                    unrollArrayRowsToUCharCvMat(cvMatResult, arrayPtr, channels, width, height, 0, height);
+                else
+                    cv::parallel_for_(cv::Range{0, height}, [&](const cv::Range& rows)
                     {
-                        auto* cvMatROIPtr = cvMatROI.ptr<uchar>(y);
-                        const auto offsetHeight = y * width;
-                        for (auto x = 0 ; x < width ; x++)
-                        {
-                            const auto value = uchar(   fastTruncate(intRound(arrayPtr[offsetHeight + x]), 0, 255)   );
-                            cvMatROIPtr[x] = (unsigned char)(value);
-                        }
-                    }
-                }
+                        unrollArrayRowsToUCharCvMat(cvMatResult, arrayPtr, channels, width, height, rows.start, rows.end);
+                    });
             }
             else
                 cvMatResult = cv::Mat{};
@@ -117,31 +235,17 @@ namespace op
         try
         {
             // float* (deep net format): C x H x W
-            // cv::Mat (OpenCV format): H x W x C 
-            const int width = cvImage.cols;
-            const int height = cvImage.rows;
-            const int channels = cvImage.channels();
-
-            const auto* const originFramePtr = cvImage.data;    // cv::Mat.data is always uchar
-            for (auto c = 0; c < channels; c++)
-            {
-                const auto floatImageOffsetC = c * height;
-                for (auto y = 0; y < height; y++)
+            // cv::Mat (OpenCV format): H x W x C
+            if (cvImage.depth() != CV_8U)
+                error("Only implemented for 8-bit images (cv::Mat depth CV_8U).", __LINE__, __FUNCTION__, __FILE__);
+            const auto height = cvImage.rows;
+            if (cvImage.cols * height < PARALLEL_CONVERSION_MIN_AREA)
+                uCharCvMatRowsToFloatPtr(floatImage, cvImage, normalize, 0, height);
+            else
+                cv::parallel_for_(cv::Range{0, height}, [&](const cv::Range& rows)
                 {
-                    const auto floatImageOffsetY = (floatImageOffsetC + y) * width;
-                    const auto originFramePtrOffsetY = y * width;
-                    for (auto x = 0; x < width; x++)
-                        floatImage[floatImageOffsetY + x] = float(originFramePtr[(originFramePtrOffsetY + x) * channels + c]);
-                }
-            }
-            // Normalizing if desired
-                // Empirically tested - OpenCV is more efficient normalizing a whole matrix/image (it uses AVX and other optimized instruction sets)
-                // In addition, the following if statement does not copy the pointer to a cv::Mat, just wrapps it
-            if (normalize)
-            {
-                cv::Mat floatImageCvWrapper{height, width, CV_32FC3, floatImage};
-                floatImageCvWrapper = floatImageCvWrapper/256.f - 0.5f;
-            }
+                    uCharCvMatRowsToFloatPtr(floatImage, cvImage, normalize, rows.start, rows.end);
+                });
         }
         catch (const std::exception& e)
         {
@@ -171,25 +275,180 @@ namespace op
         }
     }
 
+    cv::Rect getMaskBoundingBox(const cv::Mat& mask)
+    {
+        try
+        {
+            if (mask.empty())
+                return cv::Rect{};
+            if (mask.type() != CV_8UC1)
+                error("The mask must be a 1-channel 8-bit image.", __LINE__, __FUNCTION__, __FILE__);
+            std::vector<cv::Point> nonZeroPixels;
+            cv::findNonZero(mask, nonZeroPixels);
+            return (nonZeroPixels.empty() ? cv::Rect{} : cv::boundingRect(nonZeroPixels));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Rect{};
+        }
+    }
+
     cv::Mat resizeFixedAspectRatio(const cv::Mat& cvMat, const double scaleFactor, const Point<int>& targetSize, const int borderMode, const cv::Scalar& borderValue)
     {
         try
         {
-            const cv::Size cvTargetSize{targetSize.x, targetSize.y};
             cv::Mat resultingCvMat;
+            resizeFixedAspectRatio(cvMat, resultingCvMat, scaleFactor, targetSize, borderMode, borderValue);
+            return resultingCvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
+
+    void resizeFixedAspectRatio(const cv::Mat& cvMat, cv::Mat& resultingCvMat, const double scaleFactor, const Point<int>& targetSize,
+                                const int borderMode, const cv::Scalar& borderValue)
+    {
+        try
+        {
+            const cv::Size cvTargetSize{targetSize.x, targetSize.y};
             cv::Mat M = cv::Mat::eye(2,3,CV_64F);
             M.at<double>(0,0) = scaleFactor;
             M.at<double>(1,1) = scaleFactor;
             if (scaleFactor != 1. || cvTargetSize != cvMat.size())
                 cv::warpAffine(cvMat, resultingCvMat, M, cvTargetSize, (scaleFactor < 1. ? cv::INTER_AREA : cv::INTER_CUBIC), borderMode, borderValue);
-            else 
-                resultingCvMat = cvMat.clone();
-            return resultingCvMat;
+            else
+                cvMat.copyTo(resultingCvMat);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int getPyramidLevel(const std::vector<double>& pyramidScales, const double inputPixelsPerOutputPixel)
+    {
+        try
+        {
+            auto level = -1;
+            for (auto i = 0u ; i < pyramidScales.size() ; i++)
+                if (pyramidScales[i] < 1. && pyramidScales[i] * inputPixelsPerOutputPixel >= 1.)
+                    level = (int)i;
+            return level;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    int getResizeTable(std::vector<int>& indexes, std::vector<float>& weights, const int sourceSize, const int targetSize)
+    {
+        try
+        {
+            // Security checks
+            if (sourceSize < 1 || targetSize < 1)
+                error("Source and target sizes must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            const auto inverseScale = sourceSize / (double)targetSize;
+            // Downscaling (or same size) - Area interpolation: average of the source pixels covered by each target pixel
+            if (inverseScale >= 1.)
+            {
+                const auto taps = (int)std::ceil(inverseScale) + 1;
+                indexes.assign(targetSize * taps, 0);
+                weights.assign(targetSize * taps, 0.f);
+                for (auto x = 0 ; x < targetSize ; x++)
+                {
+                    const auto sourceBegin = x * inverseScale;
+                    const auto sourceEnd = fastMin(sourceBegin + inverseScale, (double)sourceSize);
+                    const auto cellWidth = sourceEnd - sourceBegin;
+                    auto tap = 0;
+                    for (auto sourceX = (int)sourceBegin ; sourceX < sourceEnd && tap < taps ; sourceX++)
+                    {
+                        const auto overlap = fastMin(sourceX + 1., sourceEnd) - fastMax((double)sourceX, sourceBegin);
+                        if (overlap > 1e-3)
+                        {
+                            indexes[x*taps + tap] = sourceX;
+                            weights[x*taps + tap] = float(overlap / cellWidth);
+                            tap++;
+                        }
+                    }
+                    // Unused taps keep weight 0, but they must point to a valid pixel
+                    for ( ; tap < taps ; tap++)
+                        indexes[x*taps + tap] = indexes[x*taps];
+                }
+                return taps;
+            }
+            // Upscaling - Bicubic interpolation (same kernel than OpenCV, A = -0.75), replicated border
+            else
+            {
+                const auto taps = 4;
+                const auto A = -0.75f;
+                indexes.resize(targetSize * taps);
+                weights.resize(targetSize * taps);
+                for (auto x = 0 ; x < targetSize ; x++)
+                {
+                    const auto sourceX = (x + 0.5) * inverseScale - 0.5;
+                    const auto sourceXFloor = (int)std::floor(sourceX);
+                    const auto t = float(sourceX - sourceXFloor);
+                    weights[x*taps] = ((A*(t + 1.f) - 5.f*A)*(t + 1.f) + 8.f*A)*(t + 1.f) - 4.f*A;
+                    weights[x*taps + 1] = ((A + 2.f)*t - (A + 3.f))*t*t + 1.f;
+                    weights[x*taps + 2] = ((A + 2.f)*(1.f - t) - (A + 3.f))*(1.f - t)*(1.f - t) + 1.f;
+                    weights[x*taps + 3] = 1.f - weights[x*taps] - weights[x*taps + 1] - weights[x*taps + 2];
+                    for (auto tap = 0 ; tap < taps ; tap++)
+                        indexes[x*taps + tap] = fastTruncate(sourceXFloor - 1 + tap, 0, sourceSize - 1);
+                }
+                return taps;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    void getFlipAndRotationAxes(bool& transpose, bool& mirrorColumns, bool& mirrorRows, const bool flip, const int rotation)
+    {
+        try
+        {
+            // Same result than the cv::transpose and cv::flip calls of Producer::flipAndRotate
+            transpose = (rotation == 90 || rotation == 270);
+            mirrorRows = (rotation == 180 || rotation == 270);
+            if (rotation == 0 || rotation == 270)
+                mirrorColumns = flip;
+            else if (rotation == 90 || rotation == 180)
+                mirrorColumns = !flip;
+            else
+                error("Rotation angle != {0, 90, 180, 270} degrees.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void flipAndRotateGpu(const cv::cuda::GpuMat& cvMat, cv::cuda::GpuMat& orientedCvMat, const bool flip, const int rotation)
+    {
+        try
+        {
+            bool transpose, mirrorColumns, mirrorRows;
+            getFlipAndRotationAxes(transpose, mirrorColumns, mirrorRows, flip, rotation);
+            // Inverse map (oriented pixel -> original pixel), integer coordinates so nearest neighbour is an exact copy
+            cv::Mat M = cv::Mat::zeros(2, 3, CV_64F);
+            M.at<double>(0, (transpose ? 1 : 0)) = (mirrorColumns ? -1. : 1.);
+            M.at<double>(0, 2) = (mirrorColumns ? cvMat.cols - 1. : 0.);
+            M.at<double>(1, (transpose ? 0 : 1)) = (mirrorRows ? -1. : 1.);
+            M.at<double>(1, 2) = (mirrorRows ? cvMat.rows - 1. : 0.);
+            const cv::Size orientedSize = (transpose ? cv::Size{cvMat.rows, cvMat.cols} : cvMat.size());
+            cv::cuda::warpAffine(cvMat, orientedCvMat, M, orientedSize, cv::INTER_NEAREST | cv::WARP_INVERSE_MAP);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return cv::Mat{};
         }
     }
 
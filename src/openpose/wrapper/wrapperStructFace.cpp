@@ -3,12 +3,15 @@
 namespace op
 {
     WrapperStructFace::WrapperStructFace(const bool enable_, const Point<int>& netInputSize_, const RenderMode renderMode_,
-                                         const float alphaKeypoint_, const float alphaHeatMap_) :
+                                         const float alphaKeypoint_, const float alphaHeatMap_, const float cacheMinIou_,
+                                         const int cacheRefreshInterval_) :
         enable{enable_},
         netInputSize{netInputSize_},
         renderMode{renderMode_},
         alphaKeypoint{alphaKeypoint_},
-        alphaHeatMap{alphaHeatMap_}
+        alphaHeatMap{alphaHeatMap_},
+        cacheMinIou{cacheMinIou_},
+        cacheRefreshInterval{cacheRefreshInterval_}
     {
     }
 }
@@ -6,7 +6,15 @@ namespace op
                                          const int gpuNumberStart_, const int scalesNumber_, const float scaleGap_, const RenderMode renderMode_,
                                          const PoseModel poseModel_, const bool blendOriginalFrame_, const float alphaKeypoint_, const float alphaHeatMap_,
                                          const int defaultPartToRender_, const std::string& modelFolder_, const std::vector<HeatMapType>& heatMapTypes_,
-                                         const ScaleMode heatMapScale_) :
+                                         const ScaleMode heatMapScale_, const int keyframeInterval_, const float trackingMinRatio_,
+                                         const float trackingMaxError_, const int roiFullFrameInterval_, const float roiPadding_,
+                                         const float motionGateThreshold_, const int motionGateMaxSkips_, const float tileScale_,
+                                         const float tileOverlap_, const float cascadeMaxHeight_, const int cascadeMaxCrops_,
+                                         const float latencyBudget_, const std::vector<Point<int>>& latencyNetInputSizes_,
+                                         const int faceHandMaxPeople_, const PersonPriority faceHandPersonPriority_,
+                                         const Point<float>& faceHandPointOfInterest_,
+                                         const PersonSelector::PriorityFunction& faceHandPriorityFunction_, const bool sparseHeatMaps_,
+                                         const bool parallelScales_, const bool dynamicNetInputWidth_) :
         netInputSize{netInputSize_},
         outputSize{outputSize_},
         keypointScale{keypointScale_},
@@ -22,7 +30,27 @@ namespace op
         defaultPartToRender{defaultPartToRender_},
         modelFolder{modelFolder_},
         heatMapTypes{heatMapTypes_},
-        heatMapScale{heatMapScale_}
+        heatMapScale{heatMapScale_},
+        keyframeInterval{keyframeInterval_},
+        trackingMinRatio{trackingMinRatio_},
+        trackingMaxError{trackingMaxError_},
+        roiFullFrameInterval{roiFullFrameInterval_},
+        roiPadding{roiPadding_},
+        motionGateThreshold{motionGateThreshold_},
+        motionGateMaxSkips{motionGateMaxSkips_},
+        tileScale{tileScale_},
+        tileOverlap{tileOverlap_},
+        cascadeMaxHeight{cascadeMaxHeight_},
+        cascadeMaxCrops{cascadeMaxCrops_},
+        latencyBudget{latencyBudget_},
+        latencyNetInputSizes{latencyNetInputSizes_},
+        faceHandMaxPeople{faceHandMaxPeople_},
+        faceHandPersonPriority{faceHandPersonPriority_},
+        faceHandPointOfInterest{faceHandPointOfInterest_},
+        faceHandPriorityFunction{faceHandPriorityFunction_},
+        sparseHeatMaps{sparseHeatMaps_},
+        parallelScales{parallelScales_},
+        dynamicNetInputWidth{dynamicNetInputWidth_}
     {
     }
 }